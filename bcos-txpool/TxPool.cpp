@@ -39,6 +39,10 @@ void TxPool::start()
         return;
     }
     m_transactionSync->start();
+    if (m_txsSnapshot)
+    {
+        m_txsSnapshot->start();
+    }
     m_running = true;
     TXPOOL_LOG(INFO) << LOG_DESC("Start the txpool.");
 }
@@ -54,6 +58,13 @@ void TxPool::stop()
     {
         m_worker->stop();
     }
+    // the batches never handled by the stopped worker
+    rejectQueuedBatches();
+    // snapshot the pending txs before the storage stopped
+    if (m_txsSnapshot)
+    {
+        m_txsSnapshot->stop();
+    }
     if (m_txpoolStorage)
     {
         m_txpoolStorage->stop();
@@ -65,7 +76,180 @@ void TxPool::stop()
 
 void TxPool::asyncSubmit(bytesPointer _txData, TxSubmitCallback _txSubmitCallback)
 {
-    asyncSubmitTransaction(_txData, _txSubmitCallback);
+    // verify and try to submit the valid transaction through the staged pipeline, the tx is
+    // rejected with TxPoolIsFull immediately once the pipeline is full
+    // Note: the group membership is checked by the pipeline worker, not the caller's thread
+    auto syncConfig = m_transactionSync->config();
+    m_txpoolStorage->asyncSubmitTransaction(
+        _txData, _txSubmitCallback, [syncConfig]() { return syncConfig->existsInGroup(); });
+}
+
+void TxPool::asyncSubmitBatch(std::shared_ptr<std::vector<bytesPointer>> _txsData,
+    std::shared_ptr<std::vector<TxSubmitCallback>> _txsSubmitCallback,
+    std::function<void(Error::Ptr, std::shared_ptr<std::vector<TransactionStatus>>)>
+        _onBatchSubmitted)
+{
+    if (!_txsData)
+    {
+        if (_onBatchSubmitted)
+        {
+            _onBatchSubmitted(std::make_shared<Error>((int32_t)TransactionStatus::Malform,
+                                  "asyncSubmitBatch failed for empty txs data"),
+                nullptr);
+        }
+        return;
+    }
+    // the txs queued by the worker are bounded by submitQueueCapacity, the batch is rejected with
+    // TxPoolIsFull immediately once the queue is full
+    // Note: the batch larger than the capacity is accepted only when nothing queued
+    auto txsSize = _txsData->size();
+    auto queuedTxsSize = (m_queuedBatchTxsSize += txsSize);
+    if (queuedTxsSize > txsSize && queuedTxsSize > m_config->submitQueueCapacity())
+    {
+        m_queuedBatchTxsSize -= txsSize;
+        TXPOOL_LOG(WARNING) << LOG_DESC("asyncSubmitBatch: reject the batch for the queue is full")
+                            << LOG_KV("txsSize", txsSize)
+                            << LOG_KV("queuedTxsSize", queuedTxsSize - txsSize);
+        rejectBatch(
+            _txsData, _txsSubmitCallback, _onBatchSubmitted, TransactionStatus::TxPoolIsFull);
+        return;
+    }
+    uint64_t batchId;
+    {
+        Guard l(x_queuedBatches);
+        batchId = m_nextBatchId++;
+        m_queuedBatches[batchId] = QueuedTxsBatch{_txsData, _txsSubmitCallback, _onBatchSubmitted};
+    }
+    auto self = std::weak_ptr<TxPool>(shared_from_this());
+    m_worker->enqueue([self, batchId, _txsData, _txsSubmitCallback, _onBatchSubmitted]() {
+        bool batchSubmitted = false;
+        try
+        {
+            auto txpool = self.lock();
+            if (!txpool || !txpool->dequeueBatch(batchId))
+            {
+                return;
+            }
+            auto txsSubmitCallback = _txsSubmitCallback ?
+                                         _txsSubmitCallback :
+                                         std::make_shared<std::vector<TxSubmitCallback>>();
+            if (!txpool->m_transactionSync->config()->existsInGroup())
+            {
+                for (auto const& callback : *txsSubmitCallback)
+                {
+                    txpool->checkExistsInGroup(callback);
+                }
+                if (_onBatchSubmitted)
+                {
+                    batchSubmitted = true;
+                    _onBatchSubmitted(
+                        std::make_shared<Error>(
+                            (int32_t)TransactionStatus::RequestNotBelongToTheGroup,
+                            "Do not send transactions to nodes that are not in the group"),
+                        nullptr);
+                }
+                return;
+            }
+            auto results =
+                txpool->m_txpoolStorage->batchSubmitTransactions(*_txsData, *txsSubmitCallback);
+            if (_onBatchSubmitted)
+            {
+                batchSubmitted = true;
+                _onBatchSubmitted(nullptr, results);
+            }
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("asyncSubmitBatch exception")
+                                << LOG_KV("errorInfo", boost::diagnostic_information(e));
+            // Note: never notify twice if the exception thrown by _onBatchSubmitted
+            if (_onBatchSubmitted && !batchSubmitted)
+            {
+                _onBatchSubmitted(
+                    std::make_shared<Error>(-1, "asyncSubmitBatch failed for exception"), nullptr);
+            }
+        }
+    });
+}
+
+bool TxPool::dequeueBatch(uint64_t _batchId)
+{
+    Guard l(x_queuedBatches);
+    auto it = m_queuedBatches.find(_batchId);
+    if (it == m_queuedBatches.end())
+    {
+        return false;
+    }
+    m_queuedBatchTxsSize -= it->second.txsData->size();
+    m_queuedBatches.erase(it);
+    return true;
+}
+
+void TxPool::rejectQueuedBatches()
+{
+    std::map<uint64_t, QueuedTxsBatch> queuedBatches;
+    {
+        Guard l(x_queuedBatches);
+        queuedBatches.swap(m_queuedBatches);
+    }
+    for (auto const& it : queuedBatches)
+    {
+        auto const& batch = it.second;
+        m_queuedBatchTxsSize -= batch.txsData->size();
+        rejectBatch(batch.txsData, batch.txsSubmitCallback, batch.onBatchSubmitted,
+            TransactionStatus::TxPoolIsFull);
+    }
+    if (!queuedBatches.empty())
+    {
+        TXPOOL_LOG(INFO) << LOG_DESC("reject the queued batches for the txpool stopped")
+                         << LOG_KV("batchSize", queuedBatches.size());
+    }
+}
+
+void TxPool::rejectBatch(std::shared_ptr<std::vector<bytesPointer>> _txsData,
+    std::shared_ptr<std::vector<TxSubmitCallback>> _txsSubmitCallback,
+    std::function<void(Error::Ptr, std::shared_ptr<std::vector<TransactionStatus>>)>
+        _onBatchSubmitted,
+    TransactionStatus _status)
+{
+    std::stringstream errorMsg;
+    errorMsg << _status;
+    if (_txsSubmitCallback)
+    {
+        for (size_t i = 0; i < _txsSubmitCallback->size(); i++)
+        {
+            auto const& callback = (*_txsSubmitCallback)[i];
+            if (!callback)
+            {
+                continue;
+            }
+            // Note: the hash is unknown if the data is missing or malformed
+            HashType txHash;
+            try
+            {
+                if (i < _txsData->size() && (*_txsData)[i])
+                {
+                    auto tx =
+                        m_config->txFactory()->createTransaction(ref(*(*_txsData)[i]), false);
+                    txHash = tx->hash();
+                }
+            }
+            catch (std::exception const& e)
+            {
+                TXPOOL_LOG(DEBUG) << LOG_DESC("rejectBatch: decode tx failed")
+                                  << LOG_KV("error", boost::diagnostic_information(e));
+            }
+            auto txResult = m_config->txResultFactory()->createTxSubmitResult();
+            txResult->setTxHash(txHash);
+            txResult->setStatus((uint32_t)_status);
+            callback(std::make_shared<Error>((int32_t)_status, errorMsg.str()), txResult);
+        }
+    }
+    if (_onBatchSubmitted)
+    {
+        _onBatchSubmitted(
+            nullptr, std::make_shared<std::vector<TransactionStatus>>(_txsData->size(), _status));
+    }
 }
 
 bool TxPool::checkExistsInGroup(TxSubmitCallback _txSubmitCallback)
@@ -94,6 +278,16 @@ void TxPool::asyncSealTxs(size_t _txsLimit, TxsHashSetPtr _avoidTxs,
     _sealCallback(nullptr, fetchedTxs, sysTxs);
 }
 
+void TxPool::asyncSealTxsWithConflictGroups(size_t _txsLimit, TxsHashSetPtr _avoidTxs,
+    std::function<void(Error::Ptr, Block::Ptr, Block::Ptr, TxsConflictGroupsPtr)> _sealCallback)
+{
+    auto fetchedTxs = m_config->blockFactory()->createBlock();
+    auto sysTxs = m_config->blockFactory()->createBlock();
+    auto conflictGroups = std::make_shared<TxsConflictGroups>();
+    m_txpoolStorage->batchFetchTxs(fetchedTxs, sysTxs, _txsLimit, _avoidTxs, true, conflictGroups);
+    _sealCallback(nullptr, fetchedTxs, sysTxs, conflictGroups);
+}
+
 void TxPool::asyncNotifyBlockResult(BlockNumber _blockNumber,
     TransactionSubmitResultsPtr _txsResult, std::function<void(Error::Ptr)> _onNotifyFinished)
 {
@@ -335,6 +529,50 @@ void TxPool::asyncResetTxPool(std::function<void(Error::Ptr)> _onRecvResponse)
     _onRecvResponse(nullptr);
 }
 
+void TxPool::initTxsSnapshot()
+{
+    if (m_config->snapshotPath().empty())
+    {
+        return;
+    }
+    auto txpoolStorage = m_txpoolStorage;
+    m_txsSnapshot = std::make_shared<TxsSnapshot>(m_config->snapshotPath(),
+        m_config->snapshotInterval(), [txpoolStorage]() { return txpoolStorage->fetchPendingTxs(); });
+    auto startT = utcTime();
+    auto encodedTxs = m_txsSnapshot->load();
+    if (encodedTxs->empty())
+    {
+        return;
+    }
+    // decode and verify the txs in parallel, the expired and committed txs are rejected by the
+    // validator with the LedgerNonceChecker
+    // Note: the reloaded txs have been broadcast and pre-committed before the restart
+    std::atomic<size_t> importedTxs = {0};
+    auto txFactory = m_config->txFactory();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, encodedTxs->size()),
+        [&](tbb::blocked_range<size_t> const& _range) {
+            for (size_t i = _range.begin(); i < _range.end(); i++)
+            {
+                try
+                {
+                    auto tx = txFactory->createTransaction(ref(*((*encodedTxs)[i])), false);
+                    if (txpoolStorage->submitReloadedTransaction(tx) == TransactionStatus::None)
+                    {
+                        importedTxs++;
+                    }
+                }
+                catch (std::exception const& e)
+                {
+                    TXPOOL_LOG(WARNING) << LOG_DESC("reload tx from snapshot exception")
+                                        << LOG_KV("error", boost::diagnostic_information(e));
+                }
+            }
+        });
+    TXPOOL_LOG(INFO) << LOG_DESC("reload txs snapshot success")
+                     << LOG_KV("snapshotTxs", encodedTxs->size())
+                     << LOG_KV("importedTxs", importedTxs) << LOG_KV("timecost", utcTime() - startT);
+}
+
 void TxPool::init()
 {
     initSendResponseHandler();
@@ -372,6 +610,10 @@ void TxPool::init()
     validator->setLedgerNonceChecker(ledgerNonceChecker);
     TXPOOL_LOG(INFO) << LOG_DESC("init txs validator success");
 
+    // the txs expire against the latest block before the first block committed
+    m_txpoolStorage->initBlockNumber(ledgerConfig->blockNumber());
+    initTxsSnapshot();
+
     // init syncConfig
     TXPOOL_LOG(INFO) << LOG_DESC("init sync config");
     auto txsSyncConfig = m_transactionSync->config();
@@ -22,8 +22,10 @@
 #include "bcos-txpool/TxPoolConfig.h"
 #include "bcos-txpool/sync/interfaces/TransactionSyncInterface.h"
 #include "bcos-txpool/txpool/interfaces/TxPoolStorageInterface.h"
+#include "bcos-txpool/txpool/storage/TxsSnapshot.h"
 #include <bcos-framework/interfaces/txpool/TxPoolInterface.h>
 #include <bcos-framework/libutilities/ThreadPool.h>
+#include <map>
 namespace bcos
 {
 namespace txpool
@@ -47,10 +49,24 @@ public:
 
     void asyncSubmit(
         bytesPointer _txData, bcos::protocol::TxSubmitCallback _txSubmitCallback) override;
+    // submit the txs in batch, the txs are verified in parallel and inserted with one lock
+    // acquisition per shard; _txsSubmitCallback is null or the callback of every tx
+    // Note: the batch is rejected with TxPoolIsFull once submitQueueCapacity txs are queued
+    virtual void asyncSubmitBatch(std::shared_ptr<std::vector<bytesPointer>> _txsData,
+        std::shared_ptr<std::vector<bcos::protocol::TxSubmitCallback>> _txsSubmitCallback,
+        std::function<void(
+            Error::Ptr, std::shared_ptr<std::vector<bcos::protocol::TransactionStatus>>)>
+            _onBatchSubmitted);
 
     void asyncSealTxs(size_t _txsLimit, TxsHashSetPtr _avoidTxs,
         std::function<void(Error::Ptr, bcos::protocol::Block::Ptr, bcos::protocol::Block::Ptr)>
             _sealCallback) override;
+    // seal the txs with the conflict groups of the normal txs, the groups are empty unless the
+    // conflictAwareSealing is enabled
+    virtual void asyncSealTxsWithConflictGroups(size_t _txsLimit, TxsHashSetPtr _avoidTxs,
+        std::function<void(Error::Ptr, bcos::protocol::Block::Ptr, bcos::protocol::Block::Ptr,
+            TxsConflictGroupsPtr)>
+            _sealCallback);
 
     void asyncNotifyBlockResult(bcos::protocol::BlockNumber _blockNumber,
         bcos::protocol::TransactionSubmitResultsPtr _txsResult,
@@ -93,6 +109,11 @@ public:
     {
         m_txpoolStorage->registerUnsealedTxsNotifier(_unsealedTxsNotifier);
     }
+    virtual void registerTxsResultNotifier(
+        std::function<void(bcos::protocol::TransactionSubmitResultsPtr)> _txsResultNotifier)
+    {
+        m_txpoolStorage->registerTxsResultNotifier(_txsResultNotifier);
+    }
 
     void asyncGetPendingTransactionSize(
         std::function<void(Error::Ptr, size_t)> _onGetTxsSize) override
@@ -129,36 +150,31 @@ protected:
         bool _fetchFromLedger = true);
 
     void initSendResponseHandler();
+    // reload the txs snapshot, and verify them with the ledger nonces
+    virtual void initTxsSnapshot();
+    // reject all the txs of the batch with _status, the txs are notified with their hashes if
+    // the data can be decoded
+    virtual void rejectBatch(std::shared_ptr<std::vector<bytesPointer>> _txsData,
+        std::shared_ptr<std::vector<bcos::protocol::TxSubmitCallback>> _txsSubmitCallback,
+        std::function<void(
+            Error::Ptr, std::shared_ptr<std::vector<bcos::protocol::TransactionStatus>>)>
+            _onBatchSubmitted,
+        bcos::protocol::TransactionStatus _status);
 
-    template <typename T>
-    void asyncSubmitTransaction(T _txData, bcos::protocol::TxSubmitCallback _txSubmitCallback)
+private:
+    // the batch queued by asyncSubmitBatch, rejected by stop if never handled by the worker
+    struct QueuedTxsBatch
     {
-        // verify and try to submit the valid transaction
-        auto self = std::weak_ptr<TxPool>(shared_from_this());
-        m_worker->enqueue([self, _txData, _txSubmitCallback]() {
-            try
-            {
-                auto txpool = self.lock();
-                if (!txpool)
-                {
-                    return;
-                }
-                if (!txpool->checkExistsInGroup(_txSubmitCallback))
-                {
-                    return;
-                }
-                auto txpoolStorage = txpool->m_txpoolStorage;
-                txpoolStorage->submitTransaction(_txData, _txSubmitCallback);
-            }
-            catch (std::exception const& e)
-            {
-                TXPOOL_LOG(WARNING) << LOG_DESC("asyncSubmit exception")
-                                    << LOG_KV("errorInfo", boost::diagnostic_information(e));
-            }
-        });
-    }
+        std::shared_ptr<std::vector<bytesPointer>> txsData;
+        std::shared_ptr<std::vector<bcos::protocol::TxSubmitCallback>> txsSubmitCallback;
+        std::function<void(
+            Error::Ptr, std::shared_ptr<std::vector<bcos::protocol::TransactionStatus>>)>
+            onBatchSubmitted;
+    };
+    // return false if the batch has been rejected by stop
+    bool dequeueBatch(uint64_t _batchId);
+    void rejectQueuedBatches();
 
-private:
     TxPoolConfig::Ptr m_config;
     TxPoolStorageInterface::Ptr m_txpoolStorage;
     bcos::sync::TransactionSyncInterface::Ptr m_transactionSync;
@@ -168,7 +184,13 @@ private:
         m_sendResponseHandler;
 
     ThreadPool::Ptr m_worker;
+    // the size of the txs queued by asyncSubmitBatch but not submitted yet
+    std::atomic<size_t> m_queuedBatchTxsSize = {0};
+    std::map<uint64_t, QueuedTxsBatch> m_queuedBatches;
+    uint64_t m_nextBatchId = 0;
+    Mutex x_queuedBatches;
     ThreadPool::Ptr m_verifier;
+    TxsSnapshot::Ptr m_txsSnapshot;
     std::atomic_bool m_running = {false};
 };
 }  // namespace txpool
@@ -23,6 +23,7 @@
 #include "bcos-txpool/txpool/interfaces/NonceCheckerInterface.h"
 #include "bcos-txpool/txpool/interfaces/TxPoolStorageInterface.h"
 #include "bcos-txpool/txpool/interfaces/TxValidatorInterface.h"
+#include "bcos-txpool/txpool/interfaces/TxsEvictionPolicyInterface.h"
 #include "interfaces/protocol/TransactionMetaData.h"
 #include <bcos-framework/interfaces/ledger/LedgerInterface.h>
 #include <bcos-framework/interfaces/protocol/BlockFactory.h>
@@ -62,9 +63,122 @@ public:
     }
     virtual size_t verifyWorkerNum() const { return m_verifyWorkerNum; }
 
+    // the workers of the other stages of the submit pipeline, the signatures are verified by the
+    // verifyWorkerNum workers
+    virtual void setDecodeWorkerNum(size_t _decodeWorkerNum)
+    {
+        m_decodeWorkerNum = _decodeWorkerNum;
+    }
+    virtual size_t decodeWorkerNum() const { return m_decodeWorkerNum; }
+
+    virtual void setCheckWorkerNum(size_t _checkWorkerNum) { m_checkWorkerNum = _checkWorkerNum; }
+    virtual size_t checkWorkerNum() const { return m_checkWorkerNum; }
+
+    virtual void setInsertWorkerNum(size_t _insertWorkerNum)
+    {
+        m_insertWorkerNum = _insertWorkerNum;
+    }
+    virtual size_t insertWorkerNum() const { return m_insertWorkerNum; }
+
+    // the max txs queued in every stage of the submit pipeline, the txs beyond are rejected
+    virtual void setSubmitQueueCapacity(size_t _submitQueueCapacity)
+    {
+        m_submitQueueCapacity = _submitQueueCapacity;
+    }
+    virtual size_t submitQueueCapacity() const { return m_submitQueueCapacity; }
+
     virtual void setPoolLimit(size_t _poolLimit) { m_poolLimit = _poolLimit; }
     virtual size_t poolLimit() const { return m_poolLimit; }
 
+    // the max memory(in bytes) occupied by the pending txs, 0 means no limit
+    virtual void setPoolMemoryLimit(uint64_t _poolMemoryLimit)
+    {
+        m_poolMemoryLimit = _poolMemoryLimit;
+    }
+    virtual uint64_t poolMemoryLimit() const { return m_poolMemoryLimit; }
+
+    // Note: must be set before the txpool storage created
+    virtual void setEvictionPolicyType(TxsEvictionPolicyType _evictionPolicyType)
+    {
+        m_evictionPolicyType = _evictionPolicyType;
+    }
+    virtual TxsEvictionPolicyType evictionPolicyType() const { return m_evictionPolicyType; }
+
+    // Note: must be set before the txpool storage created
+    virtual void setTxsShardNum(size_t _txsShardNum) { m_txsShardNum = _txsShardNum; }
+    virtual size_t txsShardNum() const { return m_txsShardNum; }
+
+    // the max number of txs stored into the ledger in one batch
+    virtual void setPreCommitBatchSize(size_t _preCommitBatchSize)
+    {
+        m_preCommitBatchSize = _preCommitBatchSize;
+    }
+    virtual size_t preCommitBatchSize() const { return m_preCommitBatchSize; }
+
+    // the max time(in ms) that the imported txs wait before stored into the ledger
+    virtual void setPreCommitInterval(uint64_t _preCommitInterval)
+    {
+        m_preCommitInterval = _preCommitInterval;
+    }
+    virtual uint64_t preCommitInterval() const { return m_preCommitInterval; }
+
+    // the file to snapshot the pending txs for warm restart, empty means disabled
+    virtual void setSnapshotPath(std::string const& _snapshotPath)
+    {
+        m_snapshotPath = _snapshotPath;
+    }
+    virtual std::string const& snapshotPath() const { return m_snapshotPath; }
+
+    // the interval(in ms) to snapshot the pending txs
+    virtual void setSnapshotInterval(uint64_t _snapshotInterval)
+    {
+        m_snapshotInterval = _snapshotInterval;
+    }
+    virtual uint64_t snapshotInterval() const { return m_snapshotInterval; }
+
+    // the interval(in ms) before requesting the missed tx again, the tx can be requested from
+    // another peer after a quarter of the interval
+    virtual void setMissedTxsExpiration(uint64_t _missedTxsExpiration)
+    {
+        m_missedTxsExpiration = _missedTxsExpiration;
+    }
+    virtual uint64_t missedTxsExpiration() const { return m_missedTxsExpiration; }
+
+    // notify the unsealed txs size to the sealer at most once every interval(in ms), unless the
+    // size changes by the threshold
+    virtual void setUnsealedTxsNotifyInterval(uint64_t _unsealedTxsNotifyInterval)
+    {
+        m_unsealedTxsNotifyInterval = _unsealedTxsNotifyInterval;
+    }
+    virtual uint64_t unsealedTxsNotifyInterval() const { return m_unsealedTxsNotifyInterval; }
+
+    virtual void setUnsealedTxsNotifyThreshold(size_t _unsealedTxsNotifyThreshold)
+    {
+        m_unsealedTxsNotifyThreshold = _unsealedTxsNotifyThreshold;
+    }
+    virtual size_t unsealedTxsNotifyThreshold() const { return m_unsealedTxsNotifyThreshold; }
+
+    // the bulk operations on more txs than the threshold handle the shards in parallel
+    virtual void setBulkParallelThreshold(size_t _bulkParallelThreshold)
+    {
+        m_bulkParallelThreshold = _bulkParallelThreshold;
+    }
+    virtual size_t bulkParallelThreshold() const { return m_bulkParallelThreshold; }
+
+    // the max txs of a sender sealed into a block, 0 means no limit
+    virtual void setMaxTxsPerSenderPerBlock(size_t _maxTxsPerSenderPerBlock)
+    {
+        m_maxTxsPerSenderPerBlock = _maxTxsPerSenderPerBlock;
+    }
+    virtual size_t maxTxsPerSenderPerBlock() const { return m_maxTxsPerSenderPerBlock; }
+
+    // group the sealed txs by the conflict keys for the parallel execution
+    virtual void setConflictAwareSealing(bool _conflictAwareSealing)
+    {
+        m_conflictAwareSealing = _conflictAwareSealing;
+    }
+    virtual bool conflictAwareSealing() const { return m_conflictAwareSealing; }
+
     NonceCheckerInterface::Ptr txPoolNonceChecker() { return m_txPoolNonceChecker; }
 
     TxValidatorInterface::Ptr txValidator() { return m_txValidator; }
@@ -93,8 +207,26 @@ private:
     std::shared_ptr<bcos::ledger::LedgerInterface> m_ledger;
     NonceCheckerInterface::Ptr m_txPoolNonceChecker;
     size_t m_poolLimit = 15000;
+    uint64_t m_poolMemoryLimit = 0;
+    // by default, the new txs are rejected when the txpool is full
+    TxsEvictionPolicyType m_evictionPolicyType = TxsEvictionPolicyType::None;
     size_t m_notifierWorkerNum = 1;
     size_t m_verifyWorkerNum = 1;
+    size_t m_decodeWorkerNum = 1;
+    size_t m_checkWorkerNum = 1;
+    size_t m_insertWorkerNum = 1;
+    size_t m_submitQueueCapacity = 10000;
+    size_t m_txsShardNum = 16;
+    size_t m_preCommitBatchSize = 1000;
+    uint64_t m_preCommitInterval = 20;
+    std::string m_snapshotPath;
+    uint64_t m_snapshotInterval = 60000;
+    uint64_t m_missedTxsExpiration = 10000;
+    uint64_t m_unsealedTxsNotifyInterval = 10;
+    size_t m_unsealedTxsNotifyThreshold = 1000;
+    size_t m_bulkParallelThreshold = 1000;
+    size_t m_maxTxsPerSenderPerBlock = 0;
+    bool m_conflictAwareSealing = false;
     int64_t m_blockLimit = 1000;
 };
 }  // namespace txpool
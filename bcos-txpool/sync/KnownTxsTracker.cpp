@@ -0,0 +1,152 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief track the transactions known by every peer
+ * @file KnownTxsTracker.cpp
+ * @author: yujiechen
+ * @date 2021-10-23
+ */
+#include "bcos-txpool/sync/KnownTxsTracker.h"
+
+using namespace bcos;
+using namespace bcos::sync;
+using namespace bcos::crypto;
+
+PeerKnownTxs::PeerKnownTxs(size_t _capacity) : m_capacity(std::max(_capacity, (size_t)1))
+{
+    size_t bitsSize = 1024;
+    while (bitsSize < m_capacity * c_bitsPerTx)
+    {
+        bitsSize <<= 1;
+    }
+    m_mask = bitsSize - 1;
+    m_generations[0].resize(bitsSize / 64, 0);
+    m_generations[1].resize(bitsSize / 64, 0);
+}
+
+size_t PeerKnownTxs::position(HashType const& _txHash, size_t _index) const
+{
+    uint64_t word = 0;
+    auto data = _txHash.data() + _index * sizeof(uint64_t);
+    for (size_t i = 0; i < sizeof(uint64_t); i++)
+    {
+        word = (word << 8) | data[i];
+    }
+    return word & m_mask;
+}
+
+bool PeerKnownTxs::containsWithoutLock(size_t _generation, HashType const& _txHash) const
+{
+    auto const& bits = m_generations[_generation];
+    for (size_t i = 0; i < c_hashFunctions; i++)
+    {
+        auto pos = position(_txHash, i);
+        if (!(bits[pos / 64] & ((uint64_t)1 << (pos % 64))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PeerKnownTxs::insert(HashType const& _txHash)
+{
+    Guard l(x_generations);
+    if (containsWithoutLock(m_current, _txHash))
+    {
+        return;
+    }
+    // roll over: drop the older generation
+    if (m_currentSize >= m_capacity)
+    {
+        m_current = 1 - m_current;
+        std::fill(m_generations[m_current].begin(), m_generations[m_current].end(), 0);
+        m_currentSize = 0;
+    }
+    auto& bits = m_generations[m_current];
+    for (size_t i = 0; i < c_hashFunctions; i++)
+    {
+        auto pos = position(_txHash, i);
+        bits[pos / 64] |= ((uint64_t)1 << (pos % 64));
+    }
+    m_currentSize++;
+}
+
+bool PeerKnownTxs::contains(HashType const& _txHash) const
+{
+    Guard l(x_generations);
+    return containsWithoutLock(0, _txHash) || containsWithoutLock(1, _txHash);
+}
+
+PeerKnownTxs::Ptr KnownTxsTracker::peerKnownTxs(NodeIDPtr _peer)
+{
+    {
+        ReadGuard l(x_peers);
+        auto it = m_peers.find(_peer);
+        if (it != m_peers.end())
+        {
+            return it->second;
+        }
+    }
+    WriteGuard l(x_peers);
+    // check again in case of the peer inserted by other threads
+    auto it = m_peers.find(_peer);
+    if (it != m_peers.end())
+    {
+        return it->second;
+    }
+    auto knownTxs = std::make_shared<PeerKnownTxs>(m_capacityPerPeer);
+    m_peers[_peer] = knownTxs;
+    return knownTxs;
+}
+
+void KnownTxsTracker::markKnown(NodeIDPtr _peer, HashType const& _txHash)
+{
+    peerKnownTxs(_peer)->insert(_txHash);
+}
+
+void KnownTxsTracker::markKnown(NodeIDPtr _peer, HashList const& _txsHash)
+{
+    auto knownTxs = peerKnownTxs(_peer);
+    for (auto const& txHash : _txsHash)
+    {
+        knownTxs->insert(txHash);
+    }
+}
+
+bool KnownTxsTracker::isKnown(NodeIDPtr _peer, HashType const& _txHash) const
+{
+    ReadGuard l(x_peers);
+    auto it = m_peers.find(_peer);
+    if (it == m_peers.end())
+    {
+        return false;
+    }
+    return it->second->contains(_txHash);
+}
+
+void KnownTxsTracker::removeStalePeers(NodeIDSet const& _connectedPeers)
+{
+    WriteGuard l(x_peers);
+    for (auto it = m_peers.begin(); it != m_peers.end();)
+    {
+        if (_connectedPeers.count(it->first))
+        {
+            it++;
+            continue;
+        }
+        it = m_peers.erase(it);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief track the transactions known by every peer
+ * @file KnownTxsTracker.h
+ * @author: yujiechen
+ * @date 2021-10-23
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace bcos
+{
+namespace sync
+{
+// rolling bloom filter of the txs known by a peer, made up of two generations, the older
+// generation is dropped once the newer one contains _capacity txs
+// Note: the false positive only makes the tx not forwarded to the peer by this node
+class PeerKnownTxs
+{
+public:
+    using Ptr = std::shared_ptr<PeerKnownTxs>;
+    explicit PeerKnownTxs(size_t _capacity);
+
+    void insert(bcos::crypto::HashType const& _txHash);
+    bool contains(bcos::crypto::HashType const& _txHash) const;
+
+private:
+    bool containsWithoutLock(size_t _generation, bcos::crypto::HashType const& _txHash) const;
+    size_t position(bcos::crypto::HashType const& _txHash, size_t _index) const;
+
+    static constexpr size_t c_hashFunctions = 3;
+    static constexpr size_t c_bitsPerTx = 10;
+
+    size_t m_capacity;
+    size_t m_mask;
+    std::vector<uint64_t> m_generations[2];
+    size_t m_current = 0;
+    size_t m_currentSize = 0;
+    mutable Mutex x_generations;
+};
+
+class KnownTxsTracker
+{
+public:
+    using Ptr = std::shared_ptr<KnownTxsTracker>;
+    explicit KnownTxsTracker(size_t _capacityPerPeer) : m_capacityPerPeer(_capacityPerPeer) {}
+
+    void markKnown(bcos::crypto::NodeIDPtr _peer, bcos::crypto::HashType const& _txHash);
+    void markKnown(bcos::crypto::NodeIDPtr _peer, bcos::crypto::HashList const& _txsHash);
+    bool isKnown(bcos::crypto::NodeIDPtr _peer, bcos::crypto::HashType const& _txHash) const;
+
+    // drop the known txs of the disconnected peers
+    void removeStalePeers(bcos::crypto::NodeIDSet const& _connectedPeers);
+
+private:
+    PeerKnownTxs::Ptr peerKnownTxs(bcos::crypto::NodeIDPtr _peer);
+
+    size_t m_capacityPerPeer;
+    std::map<bcos::crypto::NodeIDPtr, PeerKnownTxs::Ptr, bcos::crypto::KeyCompare> m_peers;
+    mutable SharedMutex x_peers;
+};
+}  // namespace sync
+}  // namespace bcos
@@ -20,6 +20,7 @@
  */
 #include "bcos-txpool/sync/TransactionSync.h"
 #include "bcos-txpool/sync/utilities/Common.h"
+#include "bcos-txpool/txpool/utilities/SlabAllocator.h"
 #include <bcos-framework/interfaces/protocol/CommonError.h>
 #include <bcos-framework/interfaces/protocol/Protocol.h>
 
@@ -491,7 +492,6 @@ bool TransactionSync::importDownloadedTxs(
                 {
                     continue;
                 }
-                tx->appendKnownNode(_fromNode);
                 if (_verifiedProposal && proposalHeader)
                 {
                     tx->setBatchId(proposalHeader->number());
@@ -515,6 +515,17 @@ bool TransactionSync::importDownloadedTxs(
                 }
             }
         });
+    // the peer knows all the txs it sent, mark them with one lookup of the peer
+    HashList txsHash;
+    txsHash.reserve(txsSize);
+    for (auto const& tx : *_txs)
+    {
+        if (tx)
+        {
+            txsHash.emplace_back(tx->hash());
+        }
+    }
+    m_knownTxs->markKnown(_fromNode, txsHash);
     if (enforceImport && !verifySuccess)
     {
         return false;
@@ -570,6 +581,7 @@ void TransactionSync::maintainTransactions()
     }
     auto consensusNodeList = m_config->consensusNodeList();
     auto connectedNodeList = m_config->connectedNodeList();
+    m_knownTxs->removeStalePeers(connectedNodeList);
     broadcastTxsFromRpc(connectedNodeList, consensusNodeList, txs);
     forwardTxsFromP2P(connectedNodeList, consensusNodeList, txs);
 }
@@ -579,7 +591,9 @@ void TransactionSync::forwardTxsFromP2P(bcos::crypto::NodeIDSet const& _connecte
     bcos::consensus::ConsensusNodeList const& _consensusNodeList, ConstTransactionsPtr _txs)
 {
     auto expectedPeers = (_connectedPeers.size() * m_config->forwardPercent() + 99) / 100;
-    std::map<NodeIDPtr, HashListPtr, KeyCompare> peerToForwardedTxs;
+    std::map<NodeIDPtr, HashListPtr, KeyCompare,
+        SlabAllocator<std::pair<const NodeIDPtr, HashListPtr>>>
+        peerToForwardedTxs;
     for (auto tx : *_txs)
     {
         // Note: in some cases the tx may be a empty shared_ptr with _vptr.Transaction to be 0x0
@@ -638,12 +652,12 @@ NodeIDListPtr TransactionSync::selectPeers(Transaction::ConstPtr _tx,
             continue;
         }
         // check tx existence
-        if (_tx->isKnownBy(nodeId))
+        if (m_knownTxs->isKnown(nodeId, _tx->hash()))
         {
             continue;
         }
         selectedPeers->emplace_back(nodeId);
-        _tx->appendKnownNode(nodeId);
+        m_knownTxs->markKnown(nodeId, _tx->hash());
         if (selectedPeers->size() >= _expectedSize)
         {
             break;
@@ -669,7 +683,7 @@ void TransactionSync::broadcastTxsFromRpc(NodeIDSet const& _connectedPeers,
             {
                 continue;
             }
-            tx->appendKnownNode(node->nodeID());
+            m_knownTxs->markKnown(node->nodeID(), tx->hash());
         }
         block->appendTransaction(std::const_pointer_cast<Transaction>(tx));
     }
@@ -709,6 +723,8 @@ void TransactionSync::onPeerTxsStatus(NodeIDPtr _fromNode, TxsSyncMsgInterface::
     {
         return;
     }
+    // the peer knows all the txs in its status packet
+    m_knownTxs->markKnown(_fromNode, _txsStatus->txsHash());
     auto requestTxs = m_config->txpoolStorage()->filterUnknownTxs(_txsStatus->txsHash(), _fromNode);
     if (requestTxs->size() == 0)
     {
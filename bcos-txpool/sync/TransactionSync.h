@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "bcos-txpool/sync/KnownTxsTracker.h"
 #include "bcos-txpool/sync/TransactionSyncConfig.h"
 #include "bcos-txpool/sync/interfaces/TransactionSyncInterface.h"
 #include <bcos-framework/interfaces/protocol/Protocol.h>
@@ -42,7 +43,8 @@ public:
         m_downloadTxsBuffer(std::make_shared<TxsSyncMsgList>()),
         m_worker(std::make_shared<ThreadPool>("sync", 1)),
         m_txsRequester(std::make_shared<ThreadPool>("txsRequester", 1)),
-        m_forwardWorker(std::make_shared<ThreadPool>("txsForward", 1))
+        m_forwardWorker(std::make_shared<ThreadPool>("txsForward", 1)),
+        m_knownTxs(std::make_shared<KnownTxsTracker>(m_config->knownTxsCapacity()))
     {
         m_txsSubmitted = m_config->txpoolStorage()->onReady([&]() { this->noteNewTransactions(); });
     }
@@ -135,6 +137,8 @@ private:
     ThreadPool::Ptr m_worker;
     ThreadPool::Ptr m_txsRequester;
     ThreadPool::Ptr m_forwardWorker;
+    // the txs known by every peer, used to avoid sending the txs back to the peers
+    KnownTxsTracker::Ptr m_knownTxs;
 
     bcos::Handler<> m_txsSubmitted;
 
@@ -60,6 +60,9 @@ public:
     unsigned forwardPercent() const { return m_forwardPercent; }
     void setForwardPercent(unsigned _forwardPercent) { m_forwardPercent = _forwardPercent; }
     std::shared_ptr<bcos::ledger::LedgerInterface> ledger() { return m_ledger; }
+    // Note: must be set before the TransactionSync created
+    size_t knownTxsCapacity() const { return m_knownTxsCapacity; }
+    void setKnownTxsCapacity(size_t _knownTxsCapacity) { m_knownTxsCapacity = _knownTxsCapacity; }
 
     // for ut
     void setTxPoolStorage(bcos::txpool::TxPoolStorageInterface::Ptr _txpoolStorage)
@@ -78,6 +81,8 @@ private:
     unsigned m_networkTimeout = 500;
 
     unsigned m_forwardPercent = 25;
+    // the txs known by every peer tracked at most
+    size_t m_knownTxsCapacity = 20000;
 };
 }  // namespace sync
 }  // namespace bcos
\ No newline at end of file
@@ -29,6 +29,18 @@ namespace bcos
 {
 namespace txpool
 {
+// the sealed txs in [offset, offset + size) of the block access the same conflict key, and are
+// independent of the txs in other groups
+struct TxsConflictGroup
+{
+    std::string to;
+    uint32_t attribute;
+    size_t offset;
+    size_t size;
+};
+using TxsConflictGroups = std::vector<TxsConflictGroup>;
+using TxsConflictGroupsPtr = std::shared_ptr<TxsConflictGroups>;
+
 class TxPoolStorageInterface
 {
 public:
@@ -42,6 +54,25 @@ public:
         bcos::protocol::Transaction::Ptr _tx,
         bcos::protocol::TxSubmitCallback _txSubmitCallback = nullptr,
         bool _enforceImport = false) = 0;
+    // submit the tx through the staged pipeline without blocking, the tx is rejected with
+    // TxPoolIsFull if the pipeline is full; the result is notified with the callback
+    // Note: _inGroup is checked by the first stage, the tx is rejected with
+    // RequestNotBelongToTheGroup if it returns false
+    virtual bcos::protocol::TransactionStatus asyncSubmitTransaction(bytesPointer _txData,
+        bcos::protocol::TxSubmitCallback _txSubmitCallback,
+        std::function<bool()> _inGroup = nullptr) = 0;
+    // decode and verify the encoded txs in parallel, and insert the valid ones in batch
+    // Note: _txsSubmitCallback is empty or the callback of every tx, the invalid txs are notified
+    // with the callbacks as well
+    virtual std::shared_ptr<std::vector<bcos::protocol::TransactionStatus>>
+    batchSubmitTransactions(std::vector<bytesPointer> const& _txsData,
+        std::vector<bcos::protocol::TxSubmitCallback> const& _txsSubmitCallback) = 0;
+
+    // verify and insert the tx reloaded from the snapshot, the tx has been broadcast before the
+    // restart so it is not broadcast again, but it is pre-committed again since the batch it
+    // belonged to may not have been flushed into the ledger
+    virtual bcos::protocol::TransactionStatus submitReloadedTransaction(
+        bcos::protocol::Transaction::Ptr _tx) = 0;
 
     virtual bcos::protocol::TransactionStatus insert(bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual void batchInsert(bcos::protocol::Transactions const& _txs) = 0;
@@ -51,6 +82,8 @@ public:
         bcos::protocol::TransactionSubmitResult::Ptr _txSubmitResult) = 0;
     virtual void batchRemove(bcos::protocol::BlockNumber _batchId,
         bcos::protocol::TransactionSubmitResults const& _txsResult) = 0;
+    // the latest committed block number, the txs expire against it before the first commit
+    virtual void initBlockNumber(bcos::protocol::BlockNumber _blockNumber) = 0;
 
     // Note: the transactions may be missing from the transaction pool
     virtual bcos::protocol::TransactionsPtr fetchTxs(
@@ -63,9 +96,13 @@ public:
      * @return List of new transactions
      */
     virtual bcos::protocol::ConstTransactionsPtr fetchNewTxs(size_t _txsLimit) = 0;
+    // fetch all the pending transactions, including the sealed ones
+    virtual bcos::protocol::ConstTransactionsPtr fetchPendingTxs() = 0;
+    // Note: the conflict groups of _txsList are exported to _conflictGroups only when
+    // conflictAwareSealing is enabled and _avoidDuplicate is true
     virtual void batchFetchTxs(bcos::protocol::Block::Ptr _txsList,
         bcos::protocol::Block::Ptr _sysTxsList, size_t _txsLimit, TxsHashSetPtr _avoidTxs,
-        bool _avoidDuplicate = true) = 0;
+        bool _avoidDuplicate = true, TxsConflictGroupsPtr _conflictGroups = nullptr) = 0;
 
     virtual bool exist(bcos::crypto::HashType const& _txHash) = 0;
 
@@ -73,6 +110,9 @@ public:
         bcos::crypto::HashList const& _txsHashList, bcos::crypto::NodeIDPtr _peer) = 0;
 
     virtual size_t size() const = 0;
+    // the estimated memory(in bytes) occupied by the pending txs, and its peak value
+    virtual uint64_t memorySize() const = 0;
+    virtual uint64_t peakMemorySize() const = 0;
     virtual void clear() = 0;
 
     // Register a handler that will be called once there is a new transaction imported
@@ -87,6 +127,15 @@ public:
         bool _sealFlag) = 0;
     virtual void batchMarkAllTxs(bool _sealFlag) = 0;
 
+    // the txs sealed for the proposal (_batchId, _batchHash)
+    virtual bcos::crypto::HashListPtr fetchProposalTxs(
+        bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash) = 0;
+    // unseal the txs of the failed proposal, return the unsealed txs size
+    virtual size_t unsealProposal(
+        bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash) = 0;
+    // unseal the txs of all the proposals with batchId larger than _batchId
+    virtual size_t unsealProposalsAbove(bcos::protocol::BlockNumber _batchId) = 0;
+
     virtual size_t unSealedTxsSize() = 0;
 
     virtual void registerUnsealedTxsNotifier(
@@ -95,6 +144,14 @@ public:
         m_unsealedTxsNotifier = _unsealedTxsNotifier;
     }
 
+    // Register a handler that receives the results of the txs submitted without callback in
+    // batches, so that RPC can fan out the receipts in bulk
+    virtual void registerTxsResultNotifier(
+        std::function<void(bcos::protocol::TransactionSubmitResultsPtr)> _txsResultNotifier)
+    {
+        m_txsResultNotifier = _txsResultNotifier;
+    }
+
     virtual void stop() = 0;
     virtual void printPendingTxs() {}
 
@@ -107,6 +164,7 @@ protected:
     bcos::CallbackCollectionHandler<> m_onReady;
     // notify the sealer the latest unsealed txs
     std::function<void(size_t, std::function<void(Error::Ptr)>)> m_unsealedTxsNotifier;
+    std::function<void(bcos::protocol::TransactionSubmitResultsPtr)> m_txsResultNotifier;
 };
 }  // namespace txpool
 }  // namespace bcos
\ No newline at end of file
@@ -34,6 +34,15 @@ public:
     virtual ~TxValidatorInterface() {}
 
     virtual bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    // the stages of verify, in the calling order
+    // check the group, the chain and the on-chain nonce, without the signature
+    virtual bcos::protocol::TransactionStatus checkTransaction(
+        bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    virtual bcos::protocol::TransactionStatus verifySignature(
+        bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    // check and update the nonces cached in the txpool
+    virtual bcos::protocol::TransactionStatus checkPoolNonce(
+        bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual NonceCheckerInterface::Ptr ledgerNonceChecker() { return m_ledgerNonceChecker; }
@@ -0,0 +1,55 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Interface to select the transaction to be evicted when the txpool is full
+ * @file TxsEvictionPolicyInterface.h
+ * @author: yujiechen
+ * @date 2021-10-19
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+namespace bcos
+{
+namespace txpool
+{
+enum class TxsEvictionPolicyType : int32_t
+{
+    // reject the new transactions when the txpool is full
+    None = 0,
+    OldestFirst = 1,
+    LowestPriorityFirst = 2,
+    SenderOverflowFirst = 3,
+};
+
+// Note: only the unsealed transactions are tracked by the policy, the sealed and the system
+// transactions are never evicted
+class TxsEvictionPolicyInterface
+{
+public:
+    using Ptr = std::shared_ptr<TxsEvictionPolicyInterface>;
+    TxsEvictionPolicyInterface() = default;
+    virtual ~TxsEvictionPolicyInterface() {}
+
+    virtual void onInsert(bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    virtual void onRemove(bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    virtual void clear() = 0;
+
+    // select the transaction to be evicted to make room for _incomingTx, return nullptr if the
+    // incoming transaction should be rejected
+    virtual bcos::protocol::Transaction::ConstPtr selectVictim(
+        bcos::protocol::Transaction::ConstPtr _incomingTx) = 0;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -19,8 +19,13 @@
  * @date 2021-05-07
  */
 #include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <tuple>
 
 using namespace bcos;
@@ -31,19 +36,121 @@ using namespace bcos::protocol;
 MemoryStorage::MemoryStorage(TxPoolConfig::Ptr _config) : m_config(_config)
 {
     m_notifier = std::make_shared<ThreadPool>("txNotifier", m_config->notifierWorkerNum());
-    m_worker = std::make_shared<ThreadPool>("txpoolWorker", 1);
+    m_preCommitter = std::make_shared<TxsPreCommitter>(
+        m_config, m_config->preCommitBatchSize(), m_config->preCommitInterval());
+    m_preCommitter->start();
+    m_unsealedTxsSizeNotifier = std::make_shared<UnsealedTxsNotifier>(
+        m_config->unsealedTxsNotifyInterval(), m_config->unsealedTxsNotifyThreshold());
+    m_unsealedTxsSizeNotifier->start();
+    auto shardNum = std::max(m_config->txsShardNum(), (size_t)1);
+    for (size_t i = 0; i < shardNum; i++)
+    {
+        m_shards.emplace_back(std::make_shared<TxsShard>());
+    }
+    m_evictionPolicy = createTxsEvictionPolicy(m_config->evictionPolicyType());
+    m_txsFilter = std::make_shared<CountingBloomFilter>(m_config->poolLimit());
+    m_senderLanes = std::make_shared<TxsSenderLanes>();
+    m_missedTxs = std::make_shared<MissedTxsTracker>(
+        m_config->missedTxsExpiration(), m_config->poolLimit());
     m_blockNumberUpdatedTime = utcTime();
+    initSubmitPipeline();
+}
+
+void MemoryStorage::initSubmitPipeline()
+{
+    m_submitPipeline = std::make_shared<TxsSubmitPipeline>(
+        [this](TxSubmitTask const& _task, TransactionStatus _status) {
+            notifyInvalidReceipt(
+                _task.tx ? _task.tx->hash() : HashType(), _status, _task.submitCallback);
+        });
+    auto capacity = m_config->submitQueueCapacity();
+    m_submitPipeline->appendStage(
+        "txsDecoder", m_config->decodeWorkerNum(), capacity, [this](TxSubmitTask& _task) {
+            if (_task.inGroup && !_task.inGroup())
+            {
+                return TransactionStatus::RequestNotBelongToTheGroup;
+            }
+            try
+            {
+                _task.tx = m_config->txFactory()->createTransaction(ref(*_task.txData), false);
+            }
+            catch (std::exception const& e)
+            {
+                TXPOOL_LOG(WARNING) << LOG_DESC("Invalid transaction for decode exception")
+                                    << LOG_KV("error", boost::diagnostic_information(e));
+                return TransactionStatus::Malform;
+            }
+            // release the encoded data early, the tx holds its own copy
+            _task.txData.reset();
+            if (_task.submitCallback)
+            {
+                _task.tx->setSubmitCallback(_task.submitCallback);
+            }
+            return TransactionStatus::None;
+        });
+    m_submitPipeline->appendStage("txsChecker", m_config->checkWorkerNum(), capacity,
+        [this](TxSubmitTask& _task) { return preCheckTransaction(_task.tx); });
+    m_submitPipeline->appendStage("txsVerifier", m_config->verifyWorkerNum(), capacity,
+        [this](TxSubmitTask& _task) { return m_config->txValidator()->verifySignature(_task.tx); });
+    m_submitPipeline->appendStage("txsInserter", m_config->insertWorkerNum(), capacity,
+        [this](TxSubmitTask& _task) { return submitVerifiedTransaction(_task.tx); });
+}
+
+std::vector<std::vector<size_t>> MemoryStorage::groupByShard(
+    size_t _txsSize, std::function<HashType(size_t)> const& _getHash) const
+{
+    std::vector<std::vector<size_t>> shardToTxs(m_shards.size());
+    for (size_t i = 0; i < _txsSize; i++)
+    {
+        shardToTxs[shardIndex(_getHash(i))].emplace_back(i);
+    }
+    return shardToTxs;
+}
+
+void MemoryStorage::forEachShard(std::vector<std::vector<size_t>> const& _shardToTxs,
+    size_t _txsSize,
+    std::function<void(TxsShard::Ptr const&, std::vector<size_t> const&)> const& _handler)
+{
+    if (_txsSize < m_config->bulkParallelThreshold())
+    {
+        for (size_t shardIdx = 0; shardIdx < _shardToTxs.size(); shardIdx++)
+        {
+            if (!_shardToTxs[shardIdx].empty())
+            {
+                _handler(m_shards[shardIdx], _shardToTxs[shardIdx]);
+            }
+        }
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _shardToTxs.size()),
+        [this, &_shardToTxs, &_handler](tbb::blocked_range<size_t> const& _range) {
+            for (size_t shardIdx = _range.begin(); shardIdx < _range.end(); shardIdx++)
+            {
+                if (!_shardToTxs[shardIdx].empty())
+                {
+                    _handler(m_shards[shardIdx], _shardToTxs[shardIdx]);
+                }
+            }
+        });
 }
 
 void MemoryStorage::stop()
 {
+    if (m_submitPipeline)
+    {
+        m_submitPipeline->stop();
+    }
     if (m_notifier)
     {
         m_notifier->stop();
     }
-    if (m_worker)
+    if (m_preCommitter)
+    {
+        m_preCommitter->stop();
+    }
+    if (m_unsealedTxsSizeNotifier)
     {
-        m_worker->stop();
+        m_unsealedTxsSizeNotifier->stop();
     }
 }
 
@@ -69,6 +176,16 @@ TransactionStatus MemoryStorage::submitTransaction(
     }
 }
 
+TransactionStatus MemoryStorage::asyncSubmitTransaction(
+    bytesPointer _txData, TxSubmitCallback _txSubmitCallback, std::function<bool()> _inGroup)
+{
+    auto task = std::make_shared<TxSubmitTask>();
+    task->txData = std::move(_txData);
+    task->submitCallback = std::move(_txSubmitCallback);
+    task->inGroup = std::move(_inGroup);
+    return m_submitPipeline->submit(task);
+}
+
 TransactionStatus MemoryStorage::txpoolStorageCheck(Transaction::ConstPtr _tx)
 {
     auto txHash = _tx->hash();
@@ -91,49 +208,45 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
 
     {
         auto txHash = _tx->hash();
+        auto const& txsShard = shard(txHash);
         // use writeGuard here in case of the transaction status will be modified by other
         // interfaces
-        UpgradableGuard l(x_txpoolMutex);
-        if (m_txsTable.count(txHash))
+        UpgradableGuard l(txsShard->x_txsTable);
+        auto it = txsShard->txsTable.find(txHash);
+        if (it != txsShard->txsTable.end())
         {
-            auto tx = m_txsTable[txHash];
-            if (!tx->sealed() || tx->batchHash() == HashType())
+            auto const& tx = it->second;
+            // sealed for the same proposal
+            if (tx->sealed() && tx->batchId() == _tx->batchId() &&
+                tx->batchHash() == _tx->batchHash())
             {
-                UpgradeGuard ul(l);
-                if (!tx->sealed())
-                {
-                    m_sealedTxsSize++;
-                    tx->setSealed(true);
-                }
-                tx->setBatchId(_tx->batchId());
-                tx->setBatchHash(_tx->batchHash());
-                TXPOOL_LOG(TRACE) << LOG_DESC("enforce to seal:") << tx->hash().abridged()
-                                  << LOG_KV("num", tx->batchId())
-                                  << LOG_KV("hash", tx->batchHash().abridged());
                 return TransactionStatus::None;
             }
-            // sealed for the same proposal
-            if (tx->batchId() == _tx->batchId() && tx->batchHash() == _tx->batchHash())
+            // the tx has been sealed by the proposal of another height
+            if (tx->sealed() && tx->batchHash() != HashType() && tx->batchId() != _tx->batchId())
             {
-                return TransactionStatus::None;
+                return TransactionStatus::AlreadyInTxPool;
             }
-            // The transaction has already been sealed by another node
-            return TransactionStatus::AlreadyInTxPool;
+            // the unsealed tx, the tx fetched but not marked, or the tx referenced by the
+            // competing proposal of the same height(e.g. re-proposed after view change)
+            UpgradeGuard ul(l);
+            {
+                WriteGuard unsealedLock(x_unsealedTxs);
+                referenceProposalWithoutLock(tx, ProposalKey(_tx->batchId(), _tx->batchHash()));
+                releaseProposalWithoutLock(tx, c_fetchedProposal);
+            }
+            TXPOOL_LOG(TRACE) << LOG_DESC("enforce to seal:") << tx->hash().abridged()
+                              << LOG_KV("num", tx->batchId())
+                              << LOG_KV("hash", tx->batchHash().abridged());
+            return TransactionStatus::None;
         }
     }
 
     // enforce import the transaction with duplicated nonce(for the consensus proposal)
-    if (!_tx->sealed())
-    {
-        m_sealedTxsSize++;
-        // avoid the sealed txs be sealed again
-        _tx->setSealed(true);
-    }
+    // avoid the sealed txs be sealed again, the sealed size is updated when insert
+    _tx->setSealed(true);
     insert(_tx);
-    {
-        WriteGuard l(x_missedTxs);
-        m_missedTxs.unsafe_erase(_tx->hash());
-    }
+    m_missedTxs->remove(_tx->hash());
     return TransactionStatus::None;
 }
 
@@ -150,32 +263,204 @@ TransactionStatus MemoryStorage::submitTransaction(
 TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     Transaction::Ptr _tx, TxSubmitCallback _txSubmitCallback)
 {
-    if (size() >= m_config->poolLimit())
+    if (_txSubmitCallback)
+    {
+        _tx->setSubmitCallback(_txSubmitCallback);
+    }
+    auto result = preCheckTransaction(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
+    }
+    result = m_config->txValidator()->verifySignature(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
+    }
+    return submitVerifiedTransaction(_tx);
+}
+
+TransactionStatus MemoryStorage::submitReloadedTransaction(Transaction::Ptr _tx)
+{
+    // the reloaded tx has been broadcast before the restart
+    _tx->setSynced(true);
+    auto result = preCheckTransaction(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
+    }
+    result = m_config->txValidator()->verifySignature(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
+    }
+    // Note: the group commit of the tx may not be flushed before the restart, pre-commit it again
+    return submitVerifiedTransaction(_tx);
+}
+
+TransactionStatus MemoryStorage::submitVerifiedTransaction(Transaction::Ptr _tx)
+{
+    // Note: this must be the last check for updating the txPoolNonceChecker
+    auto result = m_config->txValidator()->checkPoolNonce(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
+    }
+    // make room for the verified transaction
+    if (poolFull(_tx) && (!m_evictionPolicy || !evictTxs(_tx)))
     {
+        // release the nonce cached by checkPoolNonce, the rejected tx can be submitted again
+        m_config->txPoolNonceChecker()->batchRemove(NonceList{_tx->nonce()});
         return TransactionStatus::TxPoolIsFull;
     }
-    if (_txSubmitCallback)
+    _tx->setImportTime(utcTime());
+    result = insert(_tx);
+    m_missedTxs->remove(_tx->hash());
+    return result;
+}
+
+TransactionStatus MemoryStorage::verifyTransaction(Transaction::Ptr _tx)
+{
+    auto result = preCheckTransaction(_tx);
+    if (result != TransactionStatus::None)
     {
-        _tx->setSubmitCallback(_txSubmitCallback);
+        return result;
+    }
+    result = m_config->txValidator()->verifySignature(_tx);
+    if (result != TransactionStatus::None)
+    {
+        return result;
     }
+    return m_config->txValidator()->checkPoolNonce(_tx);
+}
 
+TransactionStatus MemoryStorage::preCheckTransaction(Transaction::Ptr _tx)
+{
+    // reject the transaction before verified if no room can be made for it
+    if (poolFull(_tx) && (!m_evictionPolicy || !m_evictionPolicy->selectVictim(_tx)))
+    {
+        return TransactionStatus::TxPoolIsFull;
+    }
     auto result = txpoolStorageCheck(_tx);
     if (result != TransactionStatus::None)
     {
         return result;
     }
-    // verify the transaction
-    result = m_config->txValidator()->verify(_tx);
-    if (result == TransactionStatus::None)
+    return m_config->txValidator()->checkTransaction(_tx);
+}
+
+std::shared_ptr<std::vector<TransactionStatus>> MemoryStorage::batchSubmitTransactions(
+    std::vector<bytesPointer> const& _txsData, std::vector<TxSubmitCallback> const& _txsSubmitCallback)
+{
+    auto txsSize = _txsData.size();
+    auto results = std::make_shared<std::vector<TransactionStatus>>(txsSize);
+    Transactions txs(txsSize);
+    // decode and verify the txs in parallel
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, txsSize),
+        [this, &_txsData, &txs, &results](tbb::blocked_range<size_t> const& _range) {
+            for (size_t i = _range.begin(); i < _range.end(); i++)
+            {
+                try
+                {
+                    txs[i] = m_config->txFactory()->createTransaction(ref(*_txsData[i]), false);
+                    (*results)[i] = verifyTransaction(txs[i]);
+                }
+                catch (std::exception const& e)
+                {
+                    TXPOOL_LOG(WARNING) << LOG_DESC("Invalid transaction for decode exception")
+                                        << LOG_KV("error", boost::diagnostic_information(e));
+                    (*results)[i] = TransactionStatus::Malform;
+                }
+            }
+        });
+    // make room for the verified txs, the room of the accepted txs is reserved until inserted
+    auto importTime = utcTime();
+    std::vector<size_t> verifiedTxs;
+    verifiedTxs.reserve(txsSize);
+    uint64_t reservedMemorySize = 0;
+    // the nonces cached by checkPoolNonce for the rejected txs
+    NonceList rejectedNonces;
+    for (size_t i = 0; i < txsSize; i++)
+    {
+        if ((*results)[i] != TransactionStatus::None)
+        {
+            continue;
+        }
+        auto const& tx = txs[i];
+        if (poolFull(tx, verifiedTxs.size(), reservedMemorySize) &&
+            (!m_evictionPolicy || !evictTxs(tx, verifiedTxs.size(), reservedMemorySize)))
+        {
+            (*results)[i] = TransactionStatus::TxPoolIsFull;
+            rejectedNonces.emplace_back(tx->nonce());
+            continue;
+        }
+        if (i < _txsSubmitCallback.size() && _txsSubmitCallback[i])
+        {
+            tx->setSubmitCallback(_txsSubmitCallback[i]);
+        }
+        tx->setImportTime(importTime);
+        verifiedTxs.emplace_back(i);
+        reservedMemorySize += txMemorySize(tx);
+    }
+    // insert the verified txs with one lock acquisition per shard
+    auto shardToTxs = groupByShard(verifiedTxs.size(),
+        [&txs, &verifiedTxs](size_t _index) { return txs[verifiedTxs[_index]]->hash(); });
+    forEachShard(shardToTxs, verifiedTxs.size(),
+        [this, &txs, &verifiedTxs, &results](
+            TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            WriteGuard l(_txsShard->x_txsTable);
+            // Note: the submitted txs are unsealed
+            ReadGuard unsealedLock(x_unsealedTxs);
+            for (auto const& position : _positions)
+            {
+                auto index = verifiedTxs[position];
+                auto const& tx = txs[index];
+                if (!insertToShardWithoutLock(_txsShard, tx))
+                {
+                    (*results)[index] = TransactionStatus::AlreadyInTxPool;
+                    continue;
+                }
+                _txsShard->metaTable.insert(tx);
+                insertUnsealedTxWithoutLock(tx);
+            }
+        });
+    // Note: the tx passed checkPoolNonce, so the nonce is cached by this tx rather than the
+    // pooled one with the same hash
+    for (auto index : verifiedTxs)
     {
-        _tx->setImportTime(utcTime());
-        result = insert(_tx);
+        if ((*results)[index] == TransactionStatus::AlreadyInTxPool)
         {
-            WriteGuard l(x_missedTxs);
-            m_missedTxs.unsafe_erase(_tx->hash());
+            rejectedNonces.emplace_back(txs[index]->nonce());
         }
     }
-    return result;
+    if (!rejectedNonces.empty())
+    {
+        // the rejected txs can be submitted again
+        m_config->txPoolNonceChecker()->batchRemove(rejectedNonces);
+    }
+    HashList insertedTxs;
+    insertedTxs.reserve(verifiedTxs.size());
+    for (size_t i = 0; i < txsSize; i++)
+    {
+        auto result = (*results)[i];
+        if (result == TransactionStatus::None)
+        {
+            onTxInserted(txs[i]);
+            insertedTxs.emplace_back(txs[i]->hash());
+            continue;
+        }
+        auto callback = (i < _txsSubmitCallback.size()) ? _txsSubmitCallback[i] : nullptr;
+        notifyInvalidReceipt(txs[i] ? txs[i]->hash() : HashType(), result, callback);
+    }
+    if (!insertedTxs.empty())
+    {
+        m_missedTxs->batchRemove(insertedTxs);
+        m_onReady();
+        notifyUnsealedTxsSize();
+    }
+    TXPOOL_LOG(DEBUG) << LOG_DESC("batchSubmitTransactions") << LOG_KV("txsSize", txsSize)
+                      << LOG_KV("insertedSize", insertedTxs.size());
+    return results;
 }
 
 void MemoryStorage::notifyInvalidReceipt(
@@ -196,95 +481,137 @@ void MemoryStorage::notifyInvalidReceipt(
                         << LOG_KV("tx", _txHash.abridged()) << LOG_KV("exception", _status);
 }
 
-TransactionStatus MemoryStorage::insert(Transaction::ConstPtr _tx)
+bool MemoryStorage::insertToShardWithoutLock(
+    TxsShard::Ptr const& _txsShard, Transaction::ConstPtr const& _tx)
 {
-    ReadGuard l(x_txpoolMutex);
+    auto const& txHash = _tx->hash();
+    m_txsFilter->insert(txHash);
     // check again to ensure the same transaction not be imported many times
-    if (m_txsTable.count(_tx->hash()))
+    if (_txsShard->txsTable.count(txHash))
     {
-        return TransactionStatus::AlreadyInTxPool;
+        m_txsFilter->remove(txHash);
+        return false;
+    }
+    _txsShard->txsTable[txHash] = _tx;
+    _txsShard->expiryBuckets[_tx->blockLimit()].insert(txHash);
+    m_txsSize++;
+    increaseMemorySize(txMemorySize(_tx));
+    return true;
+}
+
+void MemoryStorage::onTxInserted(Transaction::ConstPtr const& _tx)
+{
+    if (!_tx->synced())
+    {
+        m_newTxs.push(_tx);
     }
-    m_txsTable[_tx->hash()] = _tx;
-    m_onReady();
     preCommitTransaction(_tx);
-    notifyUnsealedTxsSize();
 #if FISCO_DEBUG
     // TODO: remove this, now just for bug tracing
     TXPOOL_LOG(DEBUG) << LOG_DESC("submit tx:") << _tx->hash().abridged()
                       << LOG_KV("txPointer", _tx);
 #endif
-    return TransactionStatus::None;
 }
 
-void MemoryStorage::preCommitTransaction(Transaction::ConstPtr _tx, size_t _retryTime)
+TransactionStatus MemoryStorage::insert(Transaction::ConstPtr _tx)
 {
-    if (_retryTime > 3)
+    auto const& txsShard = shard(_tx->hash());
     {
-        return;
-    }
-    auto self = std::weak_ptr<MemoryStorage>(shared_from_this());
-    m_worker->enqueue([self, _tx, _retryTime]() {
-        try
+        WriteGuard l(txsShard->x_txsTable);
+        if (!insertToShardWithoutLock(txsShard, _tx))
         {
-            auto txpoolStorage = self.lock();
-            if (!txpoolStorage)
-            {
-                return;
-            }
-            auto encodedData = _tx->encode(false);
-            auto txsToStore = std::make_shared<std::vector<bytesConstPtr>>();
-            txsToStore->emplace_back(
-                std::make_shared<bytes>(encodedData.begin(), encodedData.end()));
-            auto txsHash = std::make_shared<HashList>();
-            txsHash->emplace_back(_tx->hash());
-            txpoolStorage->m_config->ledger()->asyncStoreTransactions(
-                txsToStore, txsHash, [txpoolStorage, _tx, _retryTime](Error::Ptr _error) {
-                    if (_error == nullptr)
-                    {
-                        return;
-                    }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                    txpoolStorage->preCommitTransaction(_tx, (_retryTime + 1));
-                    TXPOOL_LOG(WARNING) << LOG_DESC("asyncPreStoreTransaction failed")
-                                        << LOG_KV("errorCode", _error->errorCode())
-                                        << LOG_KV("errorMsg", _error->errorMessage())
-                                        << LOG_KV("tx", _tx->hash().abridged());
-                });
+            return TransactionStatus::AlreadyInTxPool;
         }
-        catch (std::exception const& e)
+        if (_tx->sealed())
         {
-            TXPOOL_LOG(WARNING) << LOG_DESC("preCommitTransaction exception")
-                                << LOG_KV("error", boost::diagnostic_information(e))
-                                << LOG_KV("tx", _tx->hash().abridged());
+            txsShard->sealedTxsSize++;
+            WriteGuard unsealedLock(x_unsealedTxs);
+            txsShard->metaTable.insert(_tx);
+            referenceProposalWithoutLock(_tx, ProposalKey(_tx->batchId(), _tx->batchHash()));
         }
-    });
+        else
+        {
+            ReadGuard unsealedLock(x_unsealedTxs);
+            txsShard->metaTable.insert(_tx);
+            insertUnsealedTxWithoutLock(_tx);
+        }
+    }
+    onTxInserted(_tx);
+    m_onReady();
+    notifyUnsealedTxsSize();
+    return TransactionStatus::None;
+}
+
+void MemoryStorage::preCommitTransaction(Transaction::ConstPtr _tx)
+{
+    // the txs are stored into the ledger in batch
+    m_preCommitter->append(_tx);
 }
 
 void MemoryStorage::batchInsert(Transactions const& _txs)
 {
+    HashList txsHash;
+    txsHash.reserve(_txs.size());
     for (auto tx : _txs)
     {
         insert(tx);
+        txsHash.emplace_back(tx->hash());
     }
-    WriteGuard l(x_missedTxs);
-    for (auto tx : _txs)
+    m_missedTxs->batchRemove(txsHash);
+}
+
+Transaction::ConstPtr MemoryStorage::removeWithoutLock(
+    TxsShard::Ptr const& _txsShard, HashType const& _txHash, bool _onlyUnsealed)
+{
+    WriteGuard unsealedLock(x_unsealedTxs);
+    auto tx = eraseFromShardWithoutLock(_txsShard, _txHash, _onlyUnsealed);
+    if (tx)
     {
-        m_missedTxs.unsafe_erase(tx->hash());
+        eraseIndexesWithoutLock(tx, tx->sealed());
     }
+    return tx;
 }
 
-Transaction::ConstPtr MemoryStorage::removeWithoutLock(HashType const& _txHash)
+Transaction::ConstPtr MemoryStorage::eraseFromShardWithoutLock(
+    TxsShard::Ptr const& _txsShard, HashType const& _txHash, bool _onlyUnsealed)
 {
-    if (!m_txsTable.count(_txHash))
+    auto it = _txsShard->txsTable.find(_txHash);
+    if (it == _txsShard->txsTable.end())
+    {
+        return nullptr;
+    }
+    auto tx = it->second;
+    if (tx)
+    {
+        // Note: the sealed flag is modified under the WriteGuard of x_unsealedTxs
+        if (tx->sealed())
+        {
+            if (_onlyUnsealed)
+            {
+                return nullptr;
+            }
+            _txsShard->sealedTxsSize--;
+        }
+        _txsShard->metaTable.erase(_txHash);
+    }
+    _txsShard->txsTable.erase(it);
+    m_txsFilter->remove(_txHash);
+    m_txsSize--;
+    if (!tx)
     {
         return nullptr;
     }
-    auto tx = m_txsTable[_txHash];
-    m_txsTable.unsafe_erase(_txHash);
-    if (tx && tx->sealed())
+    auto bucket = _txsShard->expiryBuckets.find(tx->blockLimit());
+    if (bucket != _txsShard->expiryBuckets.end())
     {
-        m_sealedTxsSize--;
+        bucket->second.erase(_txHash);
+        if (bucket->second.empty())
+        {
+            _txsShard->expiryBuckets.erase(bucket);
+        }
     }
+    _txsShard->expiredSealedTxs.erase(_txHash);
+    m_memorySize -= txMemorySize(tx);
 #if FISCO_DEBUG
     // TODO: remove this, now just for bug tracing
     TXPOOL_LOG(DEBUG) << LOG_DESC("remove tx: ") << tx->hash().abridged()
@@ -294,70 +621,343 @@ Transaction::ConstPtr MemoryStorage::removeWithoutLock(HashType const& _txHash)
     return tx;
 }
 
-Transaction::ConstPtr MemoryStorage::remove(HashType const& _txHash)
+void MemoryStorage::eraseIndexesWithoutLock(Transaction::ConstPtr const& _tx, bool _sealed)
 {
-    WriteGuard l(x_txpoolMutex);
-    auto tx = removeWithoutLock(_txHash);
-    notifyUnsealedTxsSize();
-    return tx;
+    // the tx may be sealed or unsealed after erased from the shard, correct the sealed txs
+    // counted by the flag change
+    if (_tx->sealed() != _sealed)
+    {
+        auto const& txsShard = shard(_tx->hash());
+        if (_tx->sealed())
+        {
+            txsShard->sealedTxsSize--;
+        }
+        else
+        {
+            txsShard->sealedTxsSize++;
+        }
+    }
+    if (_tx->sealed())
+    {
+        eraseProposalRefsWithoutLock(_tx);
+    }
+    else
+    {
+        eraseUnsealedTxWithoutLock(_tx);
+    }
 }
 
-Transaction::ConstPtr MemoryStorage::removeSubmittedTxWithoutLock(
-    TransactionSubmitResult::Ptr _txSubmitResult)
+bool MemoryStorage::evictTxs(
+    Transaction::ConstPtr _incomingTx, size_t _reservedSize, uint64_t _reservedMemorySize)
 {
-    auto tx = removeWithoutLock(_txSubmitResult->txHash());
-    if (!tx)
+    size_t evictTimes = 0;
+    while (poolFull(_incomingTx, _reservedSize, _reservedMemorySize))
     {
-        return nullptr;
+        if (evictTimes >= c_maxEvictTimes)
+        {
+            return false;
+        }
+        evictTimes++;
+        auto victim = m_evictionPolicy->selectVictim(_incomingTx);
+        if (!victim)
+        {
+            return false;
+        }
+        evictTx(victim);
     }
-    notifyTxResult(tx, _txSubmitResult);
-    return tx;
+    return true;
 }
 
-Transaction::ConstPtr MemoryStorage::removeSubmittedTx(TransactionSubmitResult::Ptr _txSubmitResult)
+void MemoryStorage::evictTx(Transaction::ConstPtr _tx)
 {
-    auto tx = remove(_txSubmitResult->txHash());
-    if (!tx)
+    auto const& txHash = _tx->hash();
+    Transaction::ConstPtr evictedTx = nullptr;
     {
-        return nullptr;
+        auto const& txsShard = shard(txHash);
+        WriteGuard l(txsShard->x_txsTable);
+        // Note: the tx may be sealed after selected, never evict the sealed txs
+        evictedTx = removeWithoutLock(txsShard, txHash, true);
     }
-    notifyTxResult(tx, _txSubmitResult);
-    return tx;
+    if (!evictedTx)
+    {
+        return;
+    }
+    m_config->txPoolNonceChecker()->batchRemove(NonceList{evictedTx->nonce()});
+    auto txResult = m_config->txResultFactory()->createTxSubmitResult();
+    txResult->setTxHash(txHash);
+    txResult->setStatus((uint32_t)TransactionStatus::TxPoolIsFull);
+    notifyTxResult(evictedTx, txResult);
+    notifyUnsealedTxsSize();
+    TXPOOL_LOG(DEBUG) << LOG_DESC("evict tx for the txpool is full")
+                      << LOG_KV("tx", txHash.abridged()) << LOG_KV("systemTx", _tx->systemTx())
+                      << LOG_KV("pendingTxs", size());
 }
-void MemoryStorage::notifyTxResult(
-    Transaction::ConstPtr _tx, TransactionSubmitResult::Ptr _txSubmitResult)
+
+void MemoryStorage::increaseMemorySize(uint64_t _txMemorySize)
 {
-    if (!_txSubmitResult)
+    auto memorySize = (m_memorySize += _txMemorySize);
+    auto peakMemorySize = m_peakMemorySize.load();
+    while (memorySize > peakMemorySize &&
+           !m_peakMemorySize.compare_exchange_weak(peakMemorySize, memorySize))
     {
-        return;
     }
-    if (!_tx->submitCallback())
+}
+
+Transaction::ConstPtr MemoryStorage::remove(HashType const& _txHash)
+{
+    Transaction::ConstPtr tx = nullptr;
     {
-        return;
+        auto const& txsShard = shard(_txHash);
+        WriteGuard l(txsShard->x_txsTable);
+        tx = removeWithoutLock(txsShard, _txHash);
     }
-    auto txSubmitCallback = _tx->submitCallback();
-    // notify the transaction result to RPC
-    auto self = std::weak_ptr<MemoryStorage>(shared_from_this());
+    notifyUnsealedTxsSize();
+    return tx;
+}
 
-    m_notifier->enqueue([self, _tx, _txSubmitResult, txSubmitCallback]() {
-        try
+size_t MemoryStorage::batchRemoveSubmittedTxs(
+    TransactionSubmitResults const& _txsResult, NonceList& _nonceList)
+{
+    auto shardToTxs = groupByShard(
+        _txsResult.size(), [&_txsResult](size_t _index) { return _txsResult[_index]->txHash(); });
+    ConstTransactions removedTxs(_txsResult.size());
+    // Note: not std::vector<bool>, the flags are written by multiple threads
+    std::vector<uint8_t> sealedFlags(_txsResult.size(), false);
+    forEachShard(shardToTxs, _txsResult.size(),
+        [this, &_txsResult, &removedTxs, &sealedFlags](
+            TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            WriteGuard l(_txsShard->x_txsTable);
+            // the shards erase their txs in parallel with the ReadGuard of x_unsealedTxs
+            ReadGuard unsealedLock(x_unsealedTxs);
+            for (auto const& i : _positions)
+            {
+                removedTxs[i] = eraseFromShardWithoutLock(_txsShard, _txsResult[i]->txHash());
+                sealedFlags[i] = removedTxs[i] && removedTxs[i]->sealed();
+            }
+        });
+    // drop the removed txs of all the shards from the indexes with one lock acquisition
+    {
+        WriteGuard unsealedLock(x_unsealedTxs);
+        for (size_t i = 0; i < removedTxs.size(); i++)
         {
-            auto memoryStorage = self.lock();
-            if (!memoryStorage)
+            if (removedTxs[i])
             {
-                return;
+                eraseIndexesWithoutLock(removedTxs[i], sealedFlags[i]);
             }
-            txSubmitCallback(nullptr, _txSubmitResult);
         }
-        catch (std::exception const& e)
+    }
+    // notify the results without holding any lock
+    size_t succCount = 0;
+    ConstTransactions notifiedTxs;
+    TransactionSubmitResults notifiedResults;
+    notifiedTxs.reserve(_txsResult.size());
+    notifiedResults.reserve(_txsResult.size());
+    for (size_t i = 0; i < _txsResult.size(); i++)
+    {
+        auto const& txResult = _txsResult[i];
+        auto const& tx = removedTxs[i];
+        if (!tx)
         {
-            TXPOOL_LOG(WARNING) << LOG_DESC("notifyTxResult failed")
+            if (txResult->nonce() != NonceType(-1))
+            {
+                _nonceList.emplace_back(txResult->nonce());
+            }
+            continue;
+        }
+        succCount++;
+        _nonceList.emplace_back(tx->nonce());
+        notifiedTxs.emplace_back(tx);
+        notifiedResults.emplace_back(txResult);
+    }
+    notifyTxsResult(notifiedTxs, notifiedResults);
+    return succCount;
+}
+
+void MemoryStorage::removeExpiredTxs(BlockNumber _blockNumber)
+{
+    ConstTransactions expiredTxs;
+    for (auto const& txsShard : m_shards)
+    {
+        WriteGuard l(txsShard->x_txsTable);
+        auto& expiryBuckets = txsShard->expiryBuckets;
+        auto expiredEnd = expiryBuckets.upper_bound(_blockNumber);
+        if (expiredEnd == expiryBuckets.begin() && txsShard->expiredSealedTxs.empty())
+        {
+            continue;
+        }
+        // Note: the removed txs have been erased from the buckets and expiredSealedTxs
+        std::vector<HashType> expiredTxsHash(
+            txsShard->expiredSealedTxs.begin(), txsShard->expiredSealedTxs.end());
+        txsShard->expiredSealedTxs.clear();
+        for (auto it = expiryBuckets.begin(); it != expiredEnd; it++)
+        {
+            expiredTxsHash.insert(expiredTxsHash.end(), it->second.begin(), it->second.end());
+        }
+        expiryBuckets.erase(expiryBuckets.begin(), expiredEnd);
+        ReadGuard unsealedLock(x_unsealedTxs);
+        for (auto const& txHash : expiredTxsHash)
+        {
+            auto tx = eraseFromShardWithoutLock(txsShard, txHash, true);
+            if (tx)
+            {
+                expiredTxs.emplace_back(tx);
+                continue;
+            }
+            // the sealed txs are kept for the proposal, check them again with the next block
+            if (txsShard->txsTable.count(txHash))
+            {
+                txsShard->expiredSealedTxs.insert(txHash);
+            }
+        }
+    }
+    if (expiredTxs.empty())
+    {
+        return;
+    }
+    // the expired txs are unsealed when erased from the shards
+    {
+        WriteGuard unsealedLock(x_unsealedTxs);
+        for (auto const& tx : expiredTxs)
+        {
+            eraseIndexesWithoutLock(tx, false);
+        }
+    }
+    NonceList nonceList;
+    TransactionSubmitResults txsResult;
+    for (auto const& tx : expiredTxs)
+    {
+        nonceList.emplace_back(tx->nonce());
+        auto txResult = m_config->txResultFactory()->createTxSubmitResult();
+        txResult->setTxHash(tx->hash());
+        txResult->setStatus((uint32_t)TransactionStatus::BlockLimitCheckFail);
+        txsResult.emplace_back(txResult);
+    }
+    notifyTxsResult(expiredTxs, txsResult);
+    m_config->txPoolNonceChecker()->batchRemove(nonceList);
+    TXPOOL_LOG(INFO) << LOG_DESC("removeExpiredTxs") << LOG_KV("size", expiredTxs.size())
+                     << LOG_KV("number", _blockNumber);
+}
+
+Transaction::ConstPtr MemoryStorage::removeSubmittedTx(TransactionSubmitResult::Ptr _txSubmitResult)
+{
+    auto tx = remove(_txSubmitResult->txHash());
+    if (!tx)
+    {
+        return nullptr;
+    }
+    notifyTxResult(tx, _txSubmitResult);
+    return tx;
+}
+void MemoryStorage::notifyTxResult(
+    Transaction::ConstPtr _tx, TransactionSubmitResult::Ptr _txSubmitResult)
+{
+    if (!_txSubmitResult)
+    {
+        return;
+    }
+    if (!_tx->submitCallback())
+    {
+        return;
+    }
+    auto txSubmitCallback = _tx->submitCallback();
+    // notify the transaction result to RPC
+    auto self = std::weak_ptr<MemoryStorage>(shared_from_this());
+
+    m_notifier->enqueue([self, _tx, _txSubmitResult, txSubmitCallback]() {
+        try
+        {
+            auto memoryStorage = self.lock();
+            if (!memoryStorage)
+            {
+                return;
+            }
+            txSubmitCallback(nullptr, _txSubmitResult);
+        }
+        catch (std::exception const& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("notifyTxResult failed")
                                 << LOG_KV("tx", _tx->hash().abridged())
                                 << LOG_KV("errorInfo", boost::diagnostic_information(e));
         }
     });
 }
 
+void MemoryStorage::notifyTxsResult(
+    ConstTransactions const& _txs, TransactionSubmitResults const& _txsResult)
+{
+    using NotifyChunk =
+        std::vector<std::pair<Transaction::ConstPtr, TransactionSubmitResult::Ptr>>;
+    auto txsResultNotifier = m_txsResultNotifier;
+    auto workerNum = std::max(m_config->notifierWorkerNum(), (size_t)1);
+    auto chunkSize = std::max((_txs.size() + workerNum - 1) / workerNum, c_minNotifyChunkSize);
+    auto self = std::weak_ptr<MemoryStorage>(shared_from_this());
+    std::shared_ptr<NotifyChunk> chunk = nullptr;
+    for (size_t i = 0; i <= _txs.size(); i++)
+    {
+        if (chunk && (i == _txs.size() || chunk->size() >= chunkSize))
+        {
+            m_notifier->enqueue([self, chunk, txsResultNotifier]() {
+                auto memoryStorage = self.lock();
+                if (!memoryStorage)
+                {
+                    return;
+                }
+                auto bulkResults = std::make_shared<TransactionSubmitResults>();
+                for (auto const& item : *chunk)
+                {
+                    auto txSubmitCallback = item.first->submitCallback();
+                    if (!txSubmitCallback)
+                    {
+                        bulkResults->emplace_back(item.second);
+                        continue;
+                    }
+                    try
+                    {
+                        txSubmitCallback(nullptr, item.second);
+                    }
+                    catch (std::exception const& e)
+                    {
+                        TXPOOL_LOG(WARNING)
+                            << LOG_DESC("notifyTxsResult failed")
+                            << LOG_KV("tx", item.first->hash().abridged())
+                            << LOG_KV("errorInfo", boost::diagnostic_information(e));
+                    }
+                }
+                if (bulkResults->empty())
+                {
+                    return;
+                }
+                try
+                {
+                    txsResultNotifier(bulkResults);
+                }
+                catch (std::exception const& e)
+                {
+                    TXPOOL_LOG(WARNING) << LOG_DESC("notify the txs result in bulk failed")
+                                        << LOG_KV("size", bulkResults->size())
+                                        << LOG_KV("errorInfo", boost::diagnostic_information(e));
+                }
+            });
+            chunk = nullptr;
+        }
+        if (i == _txs.size())
+        {
+            break;
+        }
+        // the txs without callback are only notified to the bulk notifier
+        if (!_txsResult[i] || (!_txs[i]->submitCallback() && !txsResultNotifier))
+        {
+            continue;
+        }
+        if (!chunk)
+        {
+            chunk = std::make_shared<NotifyChunk>();
+            chunk->reserve(std::min(chunkSize, _txs.size() - i));
+        }
+        chunk->emplace_back(_txs[i], _txsResult[i]);
+    }
+}
+
 // TODO: remove this, now just for bug tracing
 void MemoryStorage::printPendingTxs()
 {
@@ -375,48 +975,54 @@ void MemoryStorage::printPendingTxs()
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("printPendingTxs for some txs unhandle")
                       << LOG_KV("pendingSize", size());
-    for (auto item : m_txsTable)
+    for (auto const& txsShard : m_shards)
     {
-        auto tx = item.second;
-        TXPOOL_LOG(DEBUG) << LOG_KV("hash", tx->hash().abridged()) << LOG_KV("id", tx->batchId())
-                          << LOG_KV("hash", tx->batchHash().abridged())
-                          << LOG_KV("seal", tx->sealed());
+        ReadGuard l(txsShard->x_txsTable);
+        ReadGuard unsealedLock(x_unsealedTxs);
+        auto const& metaTable = txsShard->metaTable;
+        for (size_t slot = 0; slot < metaTable.size(); slot++)
+        {
+            TXPOOL_LOG(DEBUG) << LOG_KV("hash", metaTable.hash(slot).abridged())
+                              << LOG_KV("id", metaTable.batchId(slot))
+                              << LOG_KV("hash", metaTable.batchHash(slot).abridged())
+                              << LOG_KV("seal", metaTable.sealed(slot));
+        }
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("printPendingTxs for some txs unhandle finish");
     m_printed = true;
 }
+void MemoryStorage::initBlockNumber(BlockNumber _blockNumber)
+{
+    if (_blockNumber > m_blockNumber)
+    {
+        m_blockNumber = _blockNumber;
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("initBlockNumber") << LOG_KV("number", _blockNumber);
+}
+
 void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults const& _txsResult)
 {
     m_blockNumberUpdatedTime = utcTime();
-    size_t succCount = 0;
     NonceListPtr nonceList = std::make_shared<NonceList>();
+    // batch remove
+    auto succCount = batchRemoveSubmittedTxs(_txsResult, *nonceList);
+    // Note: must update the blockNumber after the txs removed
+    if (_batchId > m_blockNumber)
     {
-        // batch remove
-        WriteGuard l(x_txpoolMutex);
-        for (auto txResult : _txsResult)
-        {
-            auto tx = removeSubmittedTxWithoutLock(txResult);
-
-            if (!tx && txResult->nonce() != NonceType(-1))
-            {
-                nonceList->emplace_back(txResult->nonce());
-            }
-            else if (tx)
-            {
-                succCount++;
-                nonceList->emplace_back(tx->nonce());
-            }
-        }
-        // Note: must update the blockNumber after the txs removed
-        if (_batchId > m_blockNumber)
-        {
-            m_blockNumber = _batchId;
-        }
+        m_blockNumber = _batchId;
     }
+    // the txs of the other proposals of the committed heights can be sealed again
+    {
+        WriteGuard unsealedLock(x_unsealedTxs);
+        unsealProposalsWithoutLock(m_proposalTxs.lower_bound(ProposalKey(0, HashType())),
+            m_proposalTxs.lower_bound(ProposalKey(_batchId + 1, HashType())));
+    }
+    removeExpiredTxs(_batchId);
     notifyUnsealedTxsSize();
     TXPOOL_LOG(INFO) << LOG_DESC("batchRemove txs success")
                      << LOG_KV("expectedSize", _txsResult.size()) << LOG_KV("succCount", succCount)
-                     << LOG_KV("batchId", _batchId);
+                     << LOG_KV("batchId", _batchId) << LOG_KV("memorySize", m_memorySize)
+                     << LOG_KV("peakMemorySize", m_peakMemorySize);
     // update the ledger nonce
     m_config->txValidator()->ledgerNonceChecker()->batchInsert(_batchId, nonceList);
     // update the txpool nonce
@@ -425,134 +1031,349 @@ void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults c
 
 TransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _txs)
 {
-    ReadGuard l(x_txpoolMutex);
     auto fetchedTxs = std::make_shared<Transactions>();
     _missedTxs.clear();
-    for (auto const& hash : _txs)
+    Transactions hitTxs(_txs.size());
+    auto shardToTxs = groupByShard(_txs.size(), [&_txs](size_t _index) { return _txs[_index]; });
+    forEachShard(shardToTxs, _txs.size(),
+        [&_txs, &hitTxs](TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            ReadGuard l(_txsShard->x_txsTable);
+            for (auto const& i : _positions)
+            {
+                auto it = _txsShard->txsTable.find(_txs[i]);
+                if (it == _txsShard->txsTable.end())
+                {
+                    continue;
+                }
+                hitTxs[i] = std::const_pointer_cast<Transaction>(it->second);
+            }
+        });
+    // keep the order of the given hashes
+    for (size_t i = 0; i < _txs.size(); i++)
     {
-        if (!m_txsTable.count(hash))
+        if (!hitTxs[i])
         {
-            _missedTxs.emplace_back(hash);
+            _missedTxs.emplace_back(_txs[i]);
             continue;
         }
-        auto tx = m_txsTable[hash];
-        fetchedTxs->emplace_back(std::const_pointer_cast<Transaction>(tx));
+        fetchedTxs->emplace_back(hitTxs[i]);
     }
     return fetchedTxs;
 }
 
+ConstTransactionsPtr MemoryStorage::fetchPendingTxs()
+{
+    auto pendingTxs = std::make_shared<ConstTransactions>();
+    pendingTxs->reserve(size());
+    for (auto const& txsShard : m_shards)
+    {
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto const& it : txsShard->txsTable)
+        {
+            if (it.second)
+            {
+                pendingTxs->emplace_back(it.second);
+            }
+        }
+    }
+    return pendingTxs;
+}
+
 ConstTransactionsPtr MemoryStorage::fetchNewTxs(size_t _txsLimit)
 {
-    ReadGuard l(x_txpoolMutex);
     auto fetchedTxs = std::make_shared<ConstTransactions>();
-    for (auto const& it : m_txsTable)
+    Transaction::ConstPtr tx;
+    while (fetchedTxs->size() < _txsLimit && m_newTxs.try_pop(tx))
     {
-        auto tx = it.second;
-        // Note: When inserting data into tbb::concurrent_unordered_map while traversing, it.second
-        // will occasionally be a null pointer.
-        if (!tx)
+        if (!tx || tx->synced())
         {
             continue;
         }
-        if (tx->synced())
+        // the transaction has already been committed or removed
+        if (!exist(tx->hash()))
         {
             continue;
         }
         tx->setSynced(true);
         fetchedTxs->emplace_back(tx);
-        if (fetchedTxs->size() >= _txsLimit)
-        {
-            break;
-        }
     }
     return fetchedTxs;
 }
 
+bool MemoryStorage::checkTxBeforeSeal(Transaction::ConstPtr _tx, TxsHashSetPtr _avoidTxs)
+{
+    auto const& txHash = _tx->hash();
+    if (m_invalidTxs.count(txHash))
+    {
+        return false;
+    }
+    /// check nonce again when obtain transactions
+    // since the invalid nonce has already been checked before the txs import into the
+    // txPool the txs with duplicated nonce here are already-committed, but have not been
+    // dropped
+    auto ledgerNonceChecker = m_config->txValidator()->ledgerNonceChecker();
+    if (ledgerNonceChecker && ledgerNonceChecker->exists(_tx->nonce()))
+    {
+        // in case of the same tx notified more than once
+        auto transaction = std::const_pointer_cast<Transaction>(_tx);
+        transaction->takeSubmitCallback();
+        // add to m_invalidTxs to be deleted
+        m_invalidTxs.insert(txHash);
+        m_invalidNonces.insert(_tx->nonce());
+        return false;
+    }
+    // blockLimit expired, the expired txs are mostly removed by removeExpiredTxs when the block
+    // committed, here check the txs imported concurrently with the commit
+    if (!_tx->sealed() && txExpired(_tx))
+    {
+        m_invalidTxs.insert(txHash);
+        m_invalidNonces.insert(_tx->nonce());
+        return false;
+    }
+    if (_avoidTxs && _avoidTxs->count(txHash))
+    {
+        return false;
+    }
+    return true;
+}
+
+void MemoryStorage::sealTxWithoutLock(
+    Transaction::ConstPtr _tx, Block::Ptr _txsList, Block::Ptr _sysTxsList)
+{
+    auto txMetaData = m_config->blockFactory()->createTransactionMetaData();
+    txMetaData->setHash(_tx->hash());
+    txMetaData->setTo(std::string(_tx->to()));
+    txMetaData->setAttribute(_tx->attribute());
+    if (_tx->systemTx())
+    {
+        _sysTxsList->appendTransactionMetaData(txMetaData);
+    }
+    else
+    {
+        _txsList->appendTransactionMetaData(txMetaData);
+    }
+#if FISCO_DEBUG
+    // TODO: remove this, now just for bug tracing
+    TXPOOL_LOG(INFO) << LOG_DESC("fetch ") << _tx->hash().abridged()
+                     << LOG_KV("sealed", _tx->sealed()) << LOG_KV("batchId", _tx->batchId())
+                     << LOG_KV("batchHash", _tx->batchHash().abridged())
+                     << LOG_KV("txPointer", _tx);
+#endif
+    referenceProposalWithoutLock(_tx, c_fetchedProposal);
+}
+
+void MemoryStorage::insertUnsealedTxWithoutLock(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        m_unsealedSysTxs.insert(_tx);
+    }
+    else
+    {
+        m_senderLanes->insert(_tx);
+    }
+    if (m_evictionPolicy)
+    {
+        m_evictionPolicy->onInsert(_tx);
+    }
+}
+
+void MemoryStorage::eraseUnsealedTxWithoutLock(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        m_unsealedSysTxs.unsafe_erase(_tx);
+    }
+    else
+    {
+        m_senderLanes->erase(_tx);
+    }
+    if (m_evictionPolicy)
+    {
+        m_evictionPolicy->onRemove(_tx);
+    }
+}
+
+void MemoryStorage::updateSealedFlagWithoutLock(Transaction::ConstPtr _tx, bool _sealFlag)
+{
+    if (_tx->sealed() == _sealFlag)
+    {
+        return;
+    }
+    auto const& txsShard = shard(_tx->hash());
+    _tx->setSealed(_sealFlag);
+    txsShard->metaTable.setSealed(_tx->hash(), _sealFlag);
+    if (_sealFlag)
+    {
+        eraseUnsealedTxWithoutLock(_tx);
+        txsShard->sealedTxsSize++;
+        return;
+    }
+    txsShard->sealedTxsSize--;
+    // the tx expired while sealed, remove it by removeInvalidTxs
+    if (txExpired(_tx))
+    {
+        m_invalidTxs.insert(_tx->hash());
+        m_invalidNonces.insert(_tx->nonce());
+        return;
+    }
+    insertUnsealedTxWithoutLock(_tx);
+}
+
 void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit,
-    TxsHashSetPtr _avoidTxs, bool _avoidDuplicate)
+    TxsHashSetPtr _avoidTxs, bool _avoidDuplicate, TxsConflictGroupsPtr _conflictGroups)
 {
-    auto blockFactory = m_config->blockFactory();
-    ReadGuard l(x_txpoolMutex);
-    for (auto it : m_txsTable)
+    if (_avoidDuplicate)
     {
-        auto tx = it.second;
-        // Note: When inserting data into tbb::concurrent_unordered_map while traversing,
-        // it.second will occasionally be a null pointer.
-        if (!tx)
-        {
-            continue;
-        }
-        auto txHash = tx->hash();
-        if (m_invalidTxs.count(txHash))
+        WriteGuard unsealedLock(x_unsealedTxs);
+        batchFetchUnsealedTxs(_txsList, _sysTxsList, _txsLimit, _avoidTxs, _conflictGroups);
+    }
+    else
+    {
+        batchFetchAllTxs(_txsList, _sysTxsList, _txsLimit, _avoidTxs);
+    }
+    notifyUnsealedTxsSize();
+    removeInvalidTxs();
+}
+
+void MemoryStorage::batchFetchUnsealedTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList,
+    size_t _txsLimit, TxsHashSetPtr _avoidTxs, TxsConflictGroupsPtr _conflictGroups)
+{
+    ConstTransactions fetchedTxs;
+    ConstTransactions invalidTxs;
+    auto filter = [this, &_avoidTxs, &invalidTxs](Transaction::ConstPtr const& _tx) {
+        if (checkTxBeforeSeal(_tx, _avoidTxs))
         {
-            continue;
+            return true;
         }
-        /// check nonce again when obtain transactions
-        // since the invalid nonce has already been checked before the txs import into the
-        // txPool the txs with duplicated nonce here are already-committed, but have not been
-        // dropped
-        auto result = m_config->txValidator()->submittedToChain(tx);
-        if (result == TransactionStatus::NonceCheckFail)
-        {
-            // in case of the same tx notified more than once
-            auto transaction = std::const_pointer_cast<Transaction>(tx);
-            transaction->takeSubmitCallback();
-            // add to m_invalidTxs to be deleted
-            m_invalidTxs.insert(txHash);
-            m_invalidTxs.insert(tx->nonce());
-            continue;
-        }
-        // blockLimit expired
-        if (result == TransactionStatus::BlockLimitCheckFail && !tx->sealed())
+        if (m_invalidTxs.count(_tx->hash()))
         {
-            m_invalidTxs.insert(txHash);
-            m_invalidNonces.insert(tx->nonce());
-            continue;
+            invalidTxs.emplace_back(_tx);
         }
-        if (_avoidTxs && _avoidTxs->count(txHash))
+        return false;
+    };
+    // the system txs are sealed first
+    for (auto const& tx : m_unsealedSysTxs)
+    {
+        if (fetchedTxs.size() >= _txsLimit)
         {
-            continue;
+            break;
         }
-        // the transaction has already been sealed for newer proposal
-        if (_avoidDuplicate && tx->sealed())
+        if (filter(tx))
         {
-            continue;
+            fetchedTxs.emplace_back(tx);
         }
-        auto txMetaData = m_config->blockFactory()->createTransactionMetaData();
+    }
+    // draw the other txs from the sender lanes in round-robin
+    auto sysTxsSize = fetchedTxs.size();
+    auto laneTxs = m_senderLanes->fetch(
+        _txsLimit - fetchedTxs.size(), m_config->maxTxsPerSenderPerBlock(), filter);
+    fetchedTxs.insert(fetchedTxs.end(), laneTxs.begin(), laneTxs.end());
+    if (m_config->conflictAwareSealing())
+    {
+        groupByConflictKey(fetchedTxs, sysTxsSize, _conflictGroups);
+    }
+    // the invalid txs will be removed by removeInvalidTxs, drop them from the index here
+    for (auto const& tx : invalidTxs)
+    {
+        eraseUnsealedTxWithoutLock(tx);
+    }
+    for (auto const& tx : fetchedTxs)
+    {
+        sealTxWithoutLock(tx, _txsList, _sysTxsList);
+    }
+}
 
-        txMetaData->setHash(tx->hash());
-        txMetaData->setTo(std::string(tx->to()));
-        txMetaData->setAttribute(tx->attribute());
-        if (tx->systemTx())
-        {
-            _sysTxsList->appendTransactionMetaData(txMetaData);
-        }
-        else
+void MemoryStorage::groupByConflictKey(
+    ConstTransactions& _txs, size_t _begin, TxsConflictGroupsPtr _conflictGroups)
+{
+    // the groups in the order of the first appearance, the txs of a group keep the fetched order
+    std::map<std::pair<std::string_view, uint32_t>, size_t> keyToGroup;
+    std::vector<ConstTransactions> groups;
+    for (auto i = _begin; i < _txs.size(); i++)
+    {
+        auto const& tx = _txs[i];
+        auto key = std::make_pair(tx->to(), (uint32_t)tx->attribute());
+        auto it = keyToGroup.find(key);
+        if (it == keyToGroup.end())
         {
-            _txsList->appendTransactionMetaData(txMetaData);
+            it = keyToGroup.emplace(key, groups.size()).first;
+            groups.emplace_back();
         }
-        if (!tx->sealed())
+        groups[it->second].emplace_back(tx);
+    }
+    // the largest group is the critical path of the parallel execution, seal it first
+    std::vector<size_t> order(groups.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&groups](size_t _first, size_t _second) {
+            return groups[_first].size() > groups[_second].size();
+        });
+    auto offset = _begin;
+    for (auto index : order)
+    {
+        auto& group = groups[index];
+        if (_conflictGroups)
         {
-            m_sealedTxsSize++;
+            // Note: the offset is relative to the normal txs, the system txs sealed separately
+            _conflictGroups->emplace_back(TxsConflictGroup{std::string(group.front()->to()),
+                (uint32_t)group.front()->attribute(), offset - _begin, group.size()});
         }
-#if FISCO_DEBUG
-        // TODO: remove this, now just for bug tracing
-        TXPOOL_LOG(INFO) << LOG_DESC("fetch ") << tx->hash().abridged()
-                         << LOG_KV("sealed", tx->sealed()) << LOG_KV("batchId", tx->batchId())
-                         << LOG_KV("batchHash", tx->batchHash().abridged())
-                         << LOG_KV("txPointer", tx);
-#endif
-        tx->setSealed(true);
-        tx->setBatchId(-1);
-        tx->setBatchHash(HashType());
-        if ((_txsList->transactionsMetaDataSize() + _sysTxsList->transactionsMetaDataSize()) >=
-            _txsLimit)
+        std::move(group.begin(), group.end(), _txs.begin() + offset);
+        offset += group.size();
+    }
+}
+
+void MemoryStorage::batchFetchAllTxs(
+    Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit, TxsHashSetPtr _avoidTxs)
+{
+    // Note: the sealed txs are not in the unsealed index, traverse the whole table to fetch them
+    for (auto const& txsShard : m_shards)
+    {
+        ReadGuard l(txsShard->x_txsTable);
+        WriteGuard unsealedLock(x_unsealedTxs);
+        // Note: sealing the txs modifies the fields only, the slots not moved
+        auto const& metaTable = txsShard->metaTable;
+        for (size_t slot = 0; slot < metaTable.size(); slot++)
         {
-            break;
+            // filter with the hot fields before dereferencing the tx, only the selected and the
+            // newly invalid txs are dereferenced
+            auto const& txHash = metaTable.hash(slot);
+            if (_avoidTxs && _avoidTxs->count(txHash))
+            {
+                continue;
+            }
+            if (m_invalidTxs.count(txHash))
+            {
+                continue;
+            }
+            auto sealed = metaTable.sealed(slot);
+            if (!sealed && metaTable.blockLimit(slot) <= m_blockNumber)
+            {
+                auto const& tx = metaTable.tx(slot);
+                m_invalidTxs.insert(txHash);
+                m_invalidNonces.insert(tx->nonce());
+                eraseUnsealedTxWithoutLock(tx);
+                continue;
+            }
+            auto const& tx = metaTable.tx(slot);
+            // the nonce committed by the ledger
+            if (!checkTxBeforeSeal(tx, _avoidTxs))
+            {
+                if (m_invalidTxs.count(txHash) && !sealed)
+                {
+                    eraseUnsealedTxWithoutLock(tx);
+                }
+                continue;
+            }
+            sealTxWithoutLock(tx, _txsList, _sysTxsList);
+            if ((_txsList->transactionsMetaDataSize() + _sysTxsList->transactionsMetaDataSize()) >=
+                _txsLimit)
+            {
+                return;
+            }
         }
     }
-    notifyUnsealedTxsSize();
-    removeInvalidTxs();
 }
 
 void MemoryStorage::removeInvalidTxs()
@@ -570,30 +1391,36 @@ void MemoryStorage::removeInvalidTxs()
             {
                 return;
             }
-            WriteGuard l(memoryStorage->x_txpoolMutex);
+            auto txsResult = std::make_shared<TransactionSubmitResults>();
+            auto invalidNonces = std::make_shared<NonceList>();
+            {
+                // Note: the invalid txs are collected under x_unsealedTxs when sealing
+                WriteGuard l(memoryStorage->x_unsealedTxs);
+                for (auto const& txHash : memoryStorage->m_invalidTxs)
+                {
+                    auto txResult =
+                        memoryStorage->m_config->txResultFactory()->createTxSubmitResult();
+                    txResult->setTxHash(txHash);
+                    txResult->setStatus((uint32_t)TransactionStatus::BlockLimitCheckFail);
+                    txsResult->emplace_back(txResult);
+                }
+                invalidNonces->assign(memoryStorage->m_invalidNonces.begin(),
+                    memoryStorage->m_invalidNonces.end());
+                memoryStorage->m_invalidTxs.clear();
+                memoryStorage->m_invalidNonces.clear();
+            }
             tbb::parallel_invoke(
-                [memoryStorage]() {
+                [memoryStorage, txsResult]() {
                     // remove invalid txs
-                    for (auto const& txHash : memoryStorage->m_invalidTxs)
-                    {
-                        auto txResult =
-                            memoryStorage->m_config->txResultFactory()->createTxSubmitResult();
-                        txResult->setTxHash(txHash);
-                        txResult->setStatus((uint32_t)TransactionStatus::BlockLimitCheckFail);
-
-                        memoryStorage->removeSubmittedTxWithoutLock(txResult);
-                    }
+                    NonceList nonceList;
+                    memoryStorage->batchRemoveSubmittedTxs(*txsResult, nonceList);
                     memoryStorage->notifyUnsealedTxsSize();
                 },
-                [memoryStorage]() {
+                [memoryStorage, invalidNonces]() {
                     // remove invalid nonce
-                    memoryStorage->m_config->txPoolNonceChecker()->batchRemove(
-                        memoryStorage->m_invalidNonces);
+                    memoryStorage->m_config->txPoolNonceChecker()->batchRemove(*invalidNonces);
                 });
-            TXPOOL_LOG(DEBUG) << LOG_DESC("removeInvalidTxs")
-                              << LOG_KV("size", memoryStorage->m_invalidTxs.size());
-            memoryStorage->m_invalidTxs.clear();
-            memoryStorage->m_invalidNonces.clear();
+            TXPOOL_LOG(DEBUG) << LOG_DESC("removeInvalidTxs") << LOG_KV("size", txsResult->size());
         }
         catch (std::exception const& e)
         {
@@ -605,176 +1432,378 @@ void MemoryStorage::removeInvalidTxs()
 
 void MemoryStorage::clear()
 {
-    WriteGuard l(x_txpoolMutex);
-    m_txsTable.clear();
+    for (auto const& txsShard : m_shards)
+    {
+        WriteGuard l(txsShard->x_txsTable);
+        m_txsSize -= txsShard->txsTable.size();
+        for (auto const& item : txsShard->txsTable)
+        {
+            m_txsFilter->remove(item.first);
+            if (item.second)
+            {
+                m_memorySize -= txMemorySize(item.second);
+            }
+        }
+        txsShard->txsTable.clear();
+        txsShard->expiryBuckets.clear();
+        txsShard->expiredSealedTxs.clear();
+        txsShard->sealedTxsSize = 0;
+        WriteGuard unsealedLock(x_unsealedTxs);
+        txsShard->metaTable.clear();
+    }
+    m_newTxs.clear();
+    WriteGuard unsealedLock(x_unsealedTxs);
+    m_unsealedSysTxs.clear();
+    m_senderLanes->clear();
+    m_proposalTxs.clear();
+    m_txProposals.clear();
+    if (m_evictionPolicy)
+    {
+        m_evictionPolicy->clear();
+    }
 }
 
 HashListPtr MemoryStorage::filterUnknownTxs(HashList const& _txsHashList, NodeIDPtr _peer)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto txHash : _txsHashList)
+    std::vector<bool> knownTxs(_txsHashList.size(), false);
+    // only the txs that may be in the txpool are checked with the table
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < _txsHashList.size(); i++)
     {
-        if (!m_txsTable.count(txHash))
+        if (m_txsFilter->mayContain(_txsHashList[i]))
         {
-            continue;
+            candidates.emplace_back(i);
         }
-        auto tx = m_txsTable[txHash];
-        if (!tx)
-        {
-            continue;
-        }
-        tx->appendKnownNode(_peer);
     }
-    auto unknownTxsList = std::make_shared<HashList>();
-    UpgradableGuard missedTxsLock(x_missedTxs);
-    for (auto const& txHash : _txsHashList)
+    auto shardToTxs = groupByShard(candidates.size(),
+        [&_txsHashList, &candidates](size_t _index) { return _txsHashList[candidates[_index]]; });
+    for (size_t shardIdx = 0; shardIdx < shardToTxs.size(); shardIdx++)
     {
-        if (m_txsTable.count(txHash))
+        auto const& positions = shardToTxs[shardIdx];
+        if (positions.empty())
         {
             continue;
         }
-        if (m_missedTxs.count(txHash))
+        auto const& txsShard = m_shards[shardIdx];
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto const& position : positions)
         {
-            continue;
+            auto i = candidates[position];
+            auto it = txsShard->txsTable.find(_txsHashList[i]);
+            if (it == txsShard->txsTable.end())
+            {
+                continue;
+            }
+            knownTxs[i] = true;
         }
-        unknownTxsList->push_back(txHash);
-        m_missedTxs.insert(txHash);
     }
-    if (m_missedTxs.size() >= m_config->poolLimit())
+    HashList unknownTxs;
+    for (size_t i = 0; i < _txsHashList.size(); i++)
     {
-        UpgradeGuard ul(missedTxsLock);
-        m_missedTxs.clear();
+        if (!knownTxs[i])
+        {
+            unknownTxs.emplace_back(_txsHashList[i]);
+        }
     }
-    return unknownTxsList;
+    // skip the txs requested from other peers recently
+    return m_missedTxs->request(unknownTxs, _peer);
 }
 
 void MemoryStorage::batchMarkTxs(
     HashList const& _txsHashList, BlockNumber _batchId, HashType const& _batchHash, bool _sealFlag)
 {
-    ReadGuard l(x_txpoolMutex);
     ssize_t successCount = 0;
-    for (auto txHash : _txsHashList)
+    ConstTransactions txs(_txsHashList.size());
+    auto shardToTxs = groupByShard(
+        _txsHashList.size(), [&_txsHashList](size_t _index) { return _txsHashList[_index]; });
+    // find the txs of the shards in parallel without holding x_unsealedTxs
+    forEachShard(shardToTxs, _txsHashList.size(),
+        [&_txsHashList, &txs, _sealFlag](
+            TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            ReadGuard l(_txsShard->x_txsTable);
+            for (auto const& i : _positions)
+            {
+                auto const& txHash = _txsHashList[i];
+                auto it = _txsShard->txsTable.find(txHash);
+                if (it == _txsShard->txsTable.end())
+                {
+                    TXPOOL_LOG(TRACE) << LOG_DESC("batchMarkTxs: missing transaction")
+                                      << LOG_KV("tx", txHash.abridged())
+                                      << LOG_KV("sealFlag", _sealFlag);
+                    continue;
+                }
+                txs[i] = it->second;
+            }
+        });
+    // mark the txs of all the shards with one lock acquisition
     {
-        if (!m_txsTable.count(txHash))
-        {
-            TXPOOL_LOG(TRACE) << LOG_DESC("batchMarkTxs: missing transaction")
-                              << LOG_KV("tx", txHash.abridged()) << LOG_KV("sealFlag", _sealFlag);
-            continue;
-        }
-        auto tx = m_txsTable[txHash];
-        if (!tx)
-        {
-            continue;
-        }
-        // the tx has already been re-sealed, can not enforce unseal
-        if (tx->batchHash() != HashType() && tx->batchHash() != _batchHash && !_sealFlag)
-        {
-            continue;
-        }
-        if (_sealFlag && !tx->sealed())
-        {
-            m_sealedTxsSize++;
-        }
-        if (!_sealFlag && tx->sealed())
+        ProposalKey proposal(_batchId, _batchHash);
+        WriteGuard unsealedLock(x_unsealedTxs);
+        for (auto const& tx : txs)
         {
-            m_sealedTxsSize--;
-        }
-        tx->setSealed(_sealFlag);
-        successCount += 1;
-        // set the block information for the transaction
-        if (_sealFlag)
-        {
-            tx->setBatchId(_batchId);
-            tx->setBatchHash(_batchHash);
-        }
+            // the tx removed after found is not marked
+            if (!tx || !pooledWithoutLock(tx))
+            {
+                continue;
+            }
+            if (_sealFlag)
+            {
+                referenceProposalWithoutLock(tx, proposal);
+                releaseProposalWithoutLock(tx, c_fetchedProposal);
+                successCount++;
+            }
+            else
+            {
+                // the tx referenced by other in-flight proposals is kept sealed
+                auto unsealed = releaseProposalWithoutLock(tx, proposal);
+                unsealed = releaseProposalWithoutLock(tx, c_fetchedProposal) || unsealed;
+                successCount += unsealed;
+            }
 #if FISCO_DEBUG
-        // TODO: remove this, now just for bug tracing
-        TXPOOL_LOG(DEBUG) << LOG_DESC("mark ") << tx->hash().abridged() << ":" << _sealFlag
-                          << LOG_KV("index", tx->batchId())
-                          << LOG_KV("hash", tx->batchHash().abridged()) << LOG_KV("txPointer", tx);
+            // TODO: remove this, now just for bug tracing
+            TXPOOL_LOG(DEBUG) << LOG_DESC("mark ") << tx->hash().abridged() << ":" << _sealFlag
+                              << LOG_KV("index", tx->batchId())
+                              << LOG_KV("hash", tx->batchHash().abridged())
+                              << LOG_KV("txPointer", tx);
 #endif
+        }
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("batchMarkTxs ") << LOG_KV("txsSize", _txsHashList.size())
                       << LOG_KV("batchId", _batchId) << LOG_KV("hash", _batchHash.abridged())
                       << LOG_KV("flag", _sealFlag) << LOG_KV("succ", successCount);
+    if (!_sealFlag)
+    {
+        removeInvalidTxs();
+    }
+}
+
+bool MemoryStorage::pooledWithoutLock(Transaction::ConstPtr const& _tx) const
+{
+    auto const& metaTable = shard(_tx->hash())->metaTable;
+    auto slot = metaTable.slot(_tx->hash());
+    return slot < metaTable.size() && metaTable.tx(slot) == _tx;
 }
 
 void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto item : m_txsTable)
+    if (!_sealFlag)
     {
-        auto tx = item.second;
-        if (!tx)
+        // only the sealed txs are visited
         {
-            continue;
+            WriteGuard unsealedLock(x_unsealedTxs);
+            unsealProposalsWithoutLock(m_proposalTxs.begin(), m_proposalTxs.end());
         }
-        tx->setSealed(_sealFlag);
-        if (!_sealFlag)
+        notifyUnsealedTxsSize();
+        removeInvalidTxs();
+        return;
+    }
+    for (auto const& txsShard : m_shards)
+    {
+        ReadGuard l(txsShard->x_txsTable);
+        WriteGuard unsealedLock(x_unsealedTxs);
+        // Note: marking the txs modifies the fields only, the slots not moved
+        auto const& metaTable = txsShard->metaTable;
+        for (size_t slot = 0; slot < metaTable.size(); slot++)
         {
-            tx->setBatchId(-1);
-            tx->setBatchHash(HashType());
+            if (metaTable.sealed(slot))
+            {
+                continue;
+            }
+            // referenced as the fetched txs, so that they can be unsealed by the reset
+            referenceProposalWithoutLock(metaTable.tx(slot), c_fetchedProposal);
         }
     }
-    if (_sealFlag)
+    notifyUnsealedTxsSize();
+    removeInvalidTxs();
+}
+
+HashListPtr MemoryStorage::fetchProposalTxs(BlockNumber _batchId, HashType const& _batchHash)
+{
+    auto txsHash = std::make_shared<HashList>();
+    ReadGuard unsealedLock(x_unsealedTxs);
+    auto it = m_proposalTxs.find(std::make_pair(_batchId, _batchHash));
+    if (it == m_proposalTxs.end())
     {
-        m_sealedTxsSize = m_txsTable.size();
+        return txsHash;
     }
-    else
+    txsHash->reserve(it->second.size());
+    for (auto const& item : it->second)
     {
-        m_sealedTxsSize = 0;
+        txsHash->emplace_back(item.first);
     }
+    return txsHash;
+}
+
+size_t MemoryStorage::unsealProposal(BlockNumber _batchId, HashType const& _batchHash)
+{
+    size_t unsealedSize = 0;
+    {
+        WriteGuard unsealedLock(x_unsealedTxs);
+        auto it = m_proposalTxs.find(std::make_pair(_batchId, _batchHash));
+        if (it == m_proposalTxs.end())
+        {
+            return 0;
+        }
+        unsealedSize = unsealProposalsWithoutLock(it, std::next(it));
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("unsealProposal") << LOG_KV("batchId", _batchId)
+                     << LOG_KV("batchHash", _batchHash.abridged())
+                     << LOG_KV("unsealedSize", unsealedSize);
     notifyUnsealedTxsSize();
+    removeInvalidTxs();
+    return unsealedSize;
 }
 
-size_t MemoryStorage::size() const
+size_t MemoryStorage::unsealProposalsAbove(BlockNumber _batchId)
 {
-    ReadGuard l(x_txpoolMutex);
-    return m_txsTable.size();
+    size_t unsealedSize = 0;
+    {
+        WriteGuard unsealedLock(x_unsealedTxs);
+        auto begin = m_proposalTxs.lower_bound(std::make_pair(_batchId + 1, HashType()));
+        unsealedSize = unsealProposalsWithoutLock(begin, m_proposalTxs.end());
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("unsealProposalsAbove") << LOG_KV("batchId", _batchId)
+                     << LOG_KV("unsealedSize", unsealedSize);
+    notifyUnsealedTxsSize();
+    removeInvalidTxs();
+    return unsealedSize;
 }
 
-size_t MemoryStorage::unSealedTxsSize()
+size_t MemoryStorage::unsealProposalsWithoutLock(
+    ProposalTxsIndex::iterator _begin, ProposalTxsIndex::iterator _end)
 {
-    ReadGuard l(x_txpoolMutex);
-    return unSealedTxsSizeWithoutLock();
+    ProposalTxsIndex proposals(std::make_move_iterator(_begin), std::make_move_iterator(_end));
+    m_proposalTxs.erase(_begin, _end);
+    size_t unsealedSize = 0;
+    for (auto const& proposal : proposals)
+    {
+        for (auto const& item : proposal.second)
+        {
+            if (releaseProposalWithoutLock(item.second, proposal.first))
+            {
+                unsealedSize++;
+            }
+        }
+    }
+    return unsealedSize;
 }
 
-size_t MemoryStorage::unSealedTxsSizeWithoutLock()
+void MemoryStorage::referenceProposalWithoutLock(
+    Transaction::ConstPtr _tx, ProposalKey const& _proposal)
 {
-    if (m_txsTable.size() < m_sealedTxsSize)
+    auto& proposals = m_txProposals[_tx->hash()];
+    if (std::find(proposals.begin(), proposals.end(), _proposal) == proposals.end())
     {
-        m_sealedTxsSize = m_txsTable.size();
-        return 0;
+        proposals.emplace_back(_proposal);
+        m_proposalTxs[_proposal][_tx->hash()] = _tx;
+    }
+    // the batch info is the latest proposal referencing the tx
+    setBatchWithoutLock(_tx, _proposal.first, _proposal.second);
+    updateSealedFlagWithoutLock(_tx, true);
+}
+
+void MemoryStorage::setBatchWithoutLock(
+    Transaction::ConstPtr const& _tx, BlockNumber _batchId, HashType const& _batchHash)
+{
+    _tx->setBatchId(_batchId);
+    _tx->setBatchHash(_batchHash);
+    shard(_tx->hash())->metaTable.setBatch(_tx->hash(), _batchId, _batchHash);
+}
+
+bool MemoryStorage::releaseProposalWithoutLock(
+    Transaction::ConstPtr _tx, ProposalKey const& _proposal)
+{
+    auto proposalIt = m_proposalTxs.find(_proposal);
+    if (proposalIt != m_proposalTxs.end())
+    {
+        proposalIt->second.erase(_tx->hash());
+        if (proposalIt->second.empty())
+        {
+            m_proposalTxs.erase(proposalIt);
+        }
+    }
+    auto it = m_txProposals.find(_tx->hash());
+    if (it != m_txProposals.end())
+    {
+        auto& proposals = it->second;
+        proposals.erase(
+            std::remove(proposals.begin(), proposals.end(), _proposal), proposals.end());
+        if (!proposals.empty())
+        {
+            setBatchWithoutLock(_tx, proposals.back().first, proposals.back().second);
+            return false;
+        }
+        m_txProposals.erase(it);
+    }
+    if (!_tx->sealed())
+    {
+        return false;
     }
-    return (m_txsTable.size() - m_sealedTxsSize);
+    updateSealedFlagWithoutLock(_tx, false);
+    setBatchWithoutLock(_tx, -1, HashType());
+    return true;
 }
 
-void MemoryStorage::notifyUnsealedTxsSize(size_t _retryTime)
+void MemoryStorage::eraseProposalRefsWithoutLock(Transaction::ConstPtr _tx)
 {
-    // Note: must set the notifier
-    if (!m_unsealedTxsNotifier)
+    auto it = m_txProposals.find(_tx->hash());
+    if (it == m_txProposals.end())
     {
         return;
     }
-    auto unsealedTxsSize = unSealedTxsSizeWithoutLock();
-    // TODO: remove this log
-    TXPOOL_LOG(TRACE) << LOG_DESC("notifyUnsealedTxsSize")
-                      << LOG_KV("unsealedTxsSize", unsealedTxsSize)
-                      << LOG_KV("pendingTxs", m_txsTable.size());
-    m_unsealedTxsNotifier(unsealedTxsSize, [_retryTime, this](Error::Ptr _error) {
-        if (_error == nullptr)
+    for (auto const& proposal : it->second)
+    {
+        auto proposalIt = m_proposalTxs.find(proposal);
+        if (proposalIt == m_proposalTxs.end())
         {
-            return;
+            continue;
         }
-        TXPOOL_LOG(WARNING) << LOG_DESC("notifyUnsealedTxsSize failed")
-                            << LOG_KV("errorCode", _error->errorCode())
-                            << LOG_KV("errorMsg", _error->errorMessage());
-        if (_retryTime >= c_maxRetryTime)
+        proposalIt->second.erase(_tx->hash());
+        if (proposalIt->second.empty())
         {
-            return;
+            m_proposalTxs.erase(proposalIt);
         }
-        this->notifyUnsealedTxsSize((_retryTime + 1));
-    });
+    }
+    m_txProposals.erase(it);
+}
+
+size_t MemoryStorage::size() const
+{
+    return m_txsSize;
+}
+
+size_t MemoryStorage::unSealedTxsSize()
+{
+    return unSealedTxsSizeWithoutLock();
+}
+
+size_t MemoryStorage::unSealedTxsSizeWithoutLock()
+{
+    size_t sealedTxsSize = 0;
+    for (auto const& txsShard : m_shards)
+    {
+        sealedTxsSize += txsShard->sealedTxsSize;
+    }
+    size_t txsSize = m_txsSize;
+    if (txsSize < sealedTxsSize)
+    {
+        return 0;
+    }
+    return (txsSize - sealedTxsSize);
+}
+
+void MemoryStorage::notifyUnsealedTxsSize()
+{
+    // coalesced by the notifier worker
+    m_unsealedTxsSizeNotifier->update(unSealedTxsSizeWithoutLock());
+}
+
+void MemoryStorage::registerUnsealedTxsNotifier(
+    std::function<void(size_t, std::function<void(Error::Ptr)>)> _unsealedTxsNotifier)
+{
+    TxPoolStorageInterface::registerUnsealedTxsNotifier(_unsealedTxsNotifier);
+    m_unsealedTxsSizeNotifier->setNotifier(_unsealedTxsNotifier);
+    m_unsealedTxsSizeNotifier->update(unSealedTxsSizeWithoutLock());
 }
 
 std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
@@ -785,26 +1814,48 @@ std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
     {
         return missedTxs;
     }
-    ReadGuard l(x_txpoolMutex);
+    // Note: not std::vector<bool>, the flags are written by multiple threads
+    std::vector<uint8_t> hitTxs(txsSize, false);
+    auto shardToTxs = groupByShard(
+        txsSize, [&_block](size_t _index) { return _block->transactionHash(_index); });
+    forEachShard(shardToTxs, txsSize,
+        [&_block, &hitTxs](TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            ReadGuard l(_txsShard->x_txsTable);
+            for (auto const& i : _positions)
+            {
+                hitTxs[i] = _txsShard->txsTable.count(_block->transactionHash(i));
+            }
+        });
     for (size_t i = 0; i < txsSize; i++)
     {
-        auto txHash = _block->transactionHash(i);
-        if (!(m_txsTable.count(txHash)))
+        if (!hitTxs[i])
         {
-            missedTxs->emplace_back(txHash);
+            missedTxs->emplace_back(_block->transactionHash(i));
         }
     }
     return missedTxs;
 }
 bool MemoryStorage::batchVerifyProposal(std::shared_ptr<HashList> _txsHashList)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto const& txHash : *_txsHashList)
-    {
-        if (!(m_txsTable.count(txHash)))
-        {
-            return false;
-        }
-    }
-    return true;
+    auto shardToTxs = groupByShard(_txsHashList->size(),
+        [&_txsHashList](size_t _index) { return (*_txsHashList)[_index]; });
+    std::atomic_bool missed = {false};
+    forEachShard(shardToTxs, _txsHashList->size(),
+        [&_txsHashList, &missed](
+            TxsShard::Ptr const& _txsShard, std::vector<size_t> const& _positions) {
+            if (missed)
+            {
+                return;
+            }
+            ReadGuard l(_txsShard->x_txsTable);
+            for (auto const& i : _positions)
+            {
+                if (!(_txsShard->txsTable.count((*_txsHashList)[i])))
+                {
+                    missed = true;
+                    return;
+                }
+            }
+        });
+    return !missed;
 }
@@ -20,27 +20,56 @@
  */
 #pragma once
 #include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/MissedTxsTracker.h"
+#include "bcos-txpool/txpool/storage/TxsEvictionPolicy.h"
+#include "bcos-txpool/txpool/storage/TxsMetaTable.h"
+#include "bcos-txpool/txpool/storage/TxsPreCommitter.h"
+#include "bcos-txpool/txpool/storage/TxsSenderLanes.h"
+#include "bcos-txpool/txpool/storage/TxsSubmitPipeline.h"
+#include "bcos-txpool/txpool/storage/UnsealedTxsNotifier.h"
+#include "bcos-txpool/txpool/utilities/CountingBloomFilter.h"
+#include "bcos-txpool/txpool/utilities/SlabAllocator.h"
+#include "bcos-txpool/txpool/utilities/SwissHashTable.h"
 #include <bcos-framework/libutilities/ThreadPool.h>
-#include <tbb/concurrent_unordered_map.h>
 #define TBB_PREVIEW_CONCURRENT_ORDERED_CONTAINERS 1
+#include <tbb/concurrent_queue.h>
 #include <tbb/concurrent_set.h>
+#include <map>
+#include <unordered_map>
 namespace bcos
 {
 namespace txpool
 {
-struct TransactionCompare
+// the unsealed transactions ordered by priority
+using UnsealedTxsIndex =
+    tbb::concurrent_set<bcos::protocol::Transaction::ConstPtr, TransactionCompare>;
+
+// Note: the table is guarded by the shard lock, modified only under the WriteGuard
+using TxsTable = SwissHashTable<bcos::protocol::Transaction::ConstPtr>;
+using TxsHashBucket = std::set<bcos::crypto::HashType, std::less<bcos::crypto::HashType>,
+    SlabAllocator<bcos::crypto::HashType>>;
+
+// (batchId, batchHash) => the sealed txs of the proposal
+using ProposalKey = std::pair<bcos::protocol::BlockNumber, bcos::crypto::HashType>;
+using ProposalTxs = std::unordered_map<bcos::crypto::HashType,
+    bcos::protocol::Transaction::ConstPtr, std::hash<bcos::crypto::HashType>>;
+using ProposalTxsIndex = std::map<ProposalKey, ProposalTxs>;
+
+// the transactions are partitioned into shards by hash, every shard has its own lock
+struct TxsShard
 {
-    bool operator()(bcos::protocol::Transaction::ConstPtr _first,
-        bcos::protocol::Transaction::ConstPtr _second) const
-    {
-        // high priority for system transactions
-        if (_first->systemTx() && !_second->systemTx())
-        {
-            return true;
-        }
-        // sort by importTime in ascending order
-        return _first->importTime() <= _second->importTime();
-    }
+    using Ptr = std::shared_ptr<TxsShard>;
+    TxsTable txsTable;
+    mutable SharedMutex x_txsTable;
+    std::atomic<size_t> sealedTxsSize = {0};
+    // blockLimit => txs, the txs expire once the block of the blockLimit committed
+    // Note: guarded by x_txsTable
+    std::map<bcos::protocol::BlockNumber, TxsHashBucket> expiryBuckets;
+    // the expired txs kept for the sealed proposals, checked again with every committed block
+    // Note: guarded by x_txsTable
+    TxsHashBucket expiredSealedTxs;
+    // the hot fields of the txs in the table, for the scans over the shard
+    TxsMetaTable metaTable;
 };
 class MemoryStorage : public TxPoolStorageInterface,
                       public std::enable_shared_from_this<MemoryStorage>
@@ -55,12 +84,23 @@ public:
         bcos::protocol::TxSubmitCallback _txSubmitCallback = nullptr,
         bool _enforceImport = false) override;
 
+    bcos::protocol::TransactionStatus asyncSubmitTransaction(bytesPointer _txData,
+        bcos::protocol::TxSubmitCallback _txSubmitCallback,
+        std::function<bool()> _inGroup = nullptr) override;
+    std::shared_ptr<std::vector<bcos::protocol::TransactionStatus>> batchSubmitTransactions(
+        std::vector<bytesPointer> const& _txsData,
+        std::vector<bcos::protocol::TxSubmitCallback> const& _txsSubmitCallback) override;
+
+    bcos::protocol::TransactionStatus submitReloadedTransaction(
+        bcos::protocol::Transaction::Ptr _tx) override;
+
     bcos::protocol::TransactionStatus insert(bcos::protocol::Transaction::ConstPtr _tx) override;
     void batchInsert(bcos::protocol::Transactions const& _txs) override;
 
     bcos::protocol::Transaction::ConstPtr remove(bcos::crypto::HashType const& _txHash) override;
     void batchRemove(bcos::protocol::BlockNumber _batchId,
         bcos::protocol::TransactionSubmitResults const& _txsResult) override;
+    void initBlockNumber(bcos::protocol::BlockNumber _blockNumber) override;
     bcos::protocol::Transaction::ConstPtr removeSubmittedTx(
         bcos::protocol::TransactionSubmitResult::Ptr _txSubmitResult) override;
 
@@ -68,15 +108,24 @@ public:
         bcos::crypto::HashList& _missedTxs, bcos::crypto::HashList const& _txsList) override;
 
     bcos::protocol::ConstTransactionsPtr fetchNewTxs(size_t _txsLimit) override;
+    bcos::protocol::ConstTransactionsPtr fetchPendingTxs() override;
     void batchFetchTxs(bcos::protocol::Block::Ptr _txsList, bcos::protocol::Block::Ptr _sysTxsList,
-        size_t _txsLimit, TxsHashSetPtr _avoidTxs, bool _avoidDuplicate = true) override;
+        size_t _txsLimit, TxsHashSetPtr _avoidTxs, bool _avoidDuplicate = true,
+        TxsConflictGroupsPtr _conflictGroups = nullptr) override;
 
     bool exist(bcos::crypto::HashType const& _txHash) override
     {
-        ReadGuard l(x_txpoolMutex);
-        return m_txsTable.count(_txHash);
+        if (!m_txsFilter->mayContain(_txHash))
+        {
+            return false;
+        }
+        auto const& txsShard = shard(_txHash);
+        ReadGuard l(txsShard->x_txsTable);
+        return txsShard->txsTable.count(_txHash);
     }
     size_t size() const override;
+    uint64_t memorySize() const override { return m_memorySize; }
+    uint64_t peakMemorySize() const override { return m_peakMemorySize; }
     void clear() override;
 
     bcos::crypto::HashListPtr filterUnknownTxs(
@@ -87,7 +136,15 @@ public:
         bool _sealFlag) override;
     void batchMarkAllTxs(bool _sealFlag) override;
 
+    bcos::crypto::HashListPtr fetchProposalTxs(
+        bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash) override;
+    size_t unsealProposal(
+        bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash) override;
+    size_t unsealProposalsAbove(bcos::protocol::BlockNumber _batchId) override;
+
     size_t unSealedTxsSize() override;
+    void registerUnsealedTxsNotifier(
+        std::function<void(size_t, std::function<void(Error::Ptr)>)> _unsealedTxsNotifier) override;
 
     void stop() override;
 
@@ -116,13 +173,86 @@ protected:
         bcos::protocol::Transaction::Ptr _tx);
     bcos::protocol::TransactionStatus verifyAndSubmitTransaction(
         bcos::protocol::Transaction::Ptr _tx, bcos::protocol::TxSubmitCallback _txSubmitCallback);
+    // check the capacity and the storage, and verify the tx with the validator
+    bcos::protocol::TransactionStatus verifyTransaction(bcos::protocol::Transaction::Ptr _tx);
+    // the capacity, storage and stateless checks before the signature verified
+    bcos::protocol::TransactionStatus preCheckTransaction(bcos::protocol::Transaction::Ptr _tx);
+    // the checks after the signature verified, and insert the verified tx
+    bcos::protocol::TransactionStatus submitVerifiedTransaction(
+        bcos::protocol::Transaction::Ptr _tx);
+    void initSubmitPipeline();
     size_t unSealedTxsSizeWithoutLock();
     bcos::protocol::TransactionStatus txpoolStorageCheck(bcos::protocol::Transaction::ConstPtr _tx);
 
-    virtual bcos::protocol::Transaction::ConstPtr removeWithoutLock(
-        bcos::crypto::HashType const& _txHash);
-    virtual bcos::protocol::Transaction::ConstPtr removeSubmittedTxWithoutLock(
-        bcos::protocol::TransactionSubmitResult::Ptr _txSubmitResult);
+    // the encoded size of the transaction plus the estimated overhead of the pool entry
+    uint64_t txMemorySize(bcos::protocol::Transaction::ConstPtr _tx) const
+    {
+        return _tx->encode(false).size() + c_txEntryOverhead;
+    }
+    bool exceedMemoryLimit(
+        bcos::protocol::Transaction::ConstPtr _tx, uint64_t _reservedMemorySize = 0) const
+    {
+        auto memoryLimit = m_config->poolMemoryLimit();
+        return memoryLimit > 0 &&
+               (m_memorySize + _reservedMemorySize + txMemorySize(_tx)) > memoryLimit;
+    }
+    void increaseMemorySize(uint64_t _txMemorySize);
+    bool txExpired(bcos::protocol::Transaction::ConstPtr _tx) const
+    {
+        return _tx->blockLimit() <= m_blockNumber;
+    }
+    // remove the unsealed txs whose blockLimit is not larger than _blockNumber
+    virtual void removeExpiredTxs(bcos::protocol::BlockNumber _blockNumber);
+    // _reservedSize txs of _reservedMemorySize bytes have been accepted but not inserted yet
+    bool poolFull(bcos::protocol::Transaction::ConstPtr _tx, size_t _reservedSize = 0,
+        uint64_t _reservedMemorySize = 0) const
+    {
+        return size() + _reservedSize >= m_config->poolLimit() ||
+               exceedMemoryLimit(_tx, _reservedMemorySize);
+    }
+    // evict the unsealed txs selected by the eviction policy until the txpool is not full
+    virtual bool evictTxs(bcos::protocol::Transaction::ConstPtr _incomingTx,
+        size_t _reservedSize = 0, uint64_t _reservedMemorySize = 0);
+    virtual void evictTx(bcos::protocol::Transaction::ConstPtr _tx);
+
+    size_t shardIndex(bcos::crypto::HashType const& _txHash) const
+    {
+        // Note: use the last byte of the hash, the SwissHashTable inside the shard takes its hash
+        // from the leading bytes, so that the txs of a shard still spread over its buckets
+        return _txHash.data()[bcos::crypto::HashType::size - 1] % m_shards.size();
+    }
+    TxsShard::Ptr const& shard(bcos::crypto::HashType const& _txHash) const
+    {
+        return m_shards[shardIndex(_txHash)];
+    }
+    // group the positions of the given hashes by shard, so that every shard is locked only once
+    std::vector<std::vector<size_t>> groupByShard(
+        size_t _txsSize, std::function<bcos::crypto::HashType(size_t)> const& _getHash) const;
+    // call _handler with every shard that has txs, the shards are handled in parallel if there
+    // are more than bulkParallelThreshold txs
+    // Note: the _handler should only write the results of its own positions
+    void forEachShard(std::vector<std::vector<size_t>> const& _shardToTxs, size_t _txsSize,
+        std::function<void(TxsShard::Ptr const&, std::vector<size_t> const&)> const& _handler);
+
+    // Note: the WriteGuard of the shard should be held by the caller, the sealed tx will not be
+    // removed if _onlyUnsealed is true
+    virtual bcos::protocol::Transaction::ConstPtr removeWithoutLock(TxsShard::Ptr const& _txsShard,
+        bcos::crypto::HashType const& _txHash, bool _onlyUnsealed = false);
+    // erase the tx from the table of the shard, the caller should drop the erased tx from the
+    // indexes by eraseIndexesWithoutLock later, so that the shards can be erased in parallel
+    // Note: the WriteGuard of the shard and the ReadGuard of x_unsealedTxs should be held
+    bcos::protocol::Transaction::ConstPtr eraseFromShardWithoutLock(TxsShard::Ptr const& _txsShard,
+        bcos::crypto::HashType const& _txHash, bool _onlyUnsealed = false);
+    // drop the erased tx from the unsealed index and the proposals, _sealed is the sealed flag
+    // when the tx erased from the shard
+    // Note: the WriteGuard of x_unsealedTxs should be held by the caller
+    void eraseIndexesWithoutLock(bcos::protocol::Transaction::ConstPtr const& _tx, bool _sealed);
+    // whether the tx is still in the txpool, x_unsealedTxs should be held by the caller
+    bool pooledWithoutLock(bcos::protocol::Transaction::ConstPtr const& _tx) const;
+    // remove the committed or invalid txs, and notify the results after the locks released
+    virtual size_t batchRemoveSubmittedTxs(
+        bcos::protocol::TransactionSubmitResults const& _txsResult,
+        bcos::protocol::NonceList& _nonceList);
 
     virtual void notifyInvalidReceipt(bcos::crypto::HashType const& _txHash,
         bcos::protocol::TransactionStatus _status,
@@ -130,37 +260,115 @@ protected:
 
     virtual void notifyTxResult(bcos::protocol::Transaction::ConstPtr _tx,
         bcos::protocol::TransactionSubmitResult::Ptr _txSubmitResult);
+    // notify the results in chunks spread across the notifier workers, instead of enqueuing a
+    // task for every result
+    virtual void notifyTxsResult(bcos::protocol::ConstTransactions const& _txs,
+        bcos::protocol::TransactionSubmitResults const& _txsResult);
 
     virtual void removeInvalidTxs();
 
-    virtual void preCommitTransaction(
-        bcos::protocol::Transaction::ConstPtr _tx, size_t _retryTime = 0);
+    virtual void preCommitTransaction(bcos::protocol::Transaction::ConstPtr _tx);
+    // insert the tx into the table of the shard, return false if the tx already exists
+    // Note: the WriteGuard of the shard should be held by the caller
+    bool insertToShardWithoutLock(
+        TxsShard::Ptr const& _txsShard, bcos::protocol::Transaction::ConstPtr const& _tx);
+    // broadcast and pre-commit the inserted tx, out of the locks
+    void onTxInserted(bcos::protocol::Transaction::ConstPtr const& _tx);
+
+    virtual void notifyUnsealedTxsSize();
 
-    virtual void notifyUnsealedTxsSize(size_t _retryTime = 0);
+    // Note: return false if the transaction should not be sealed
+    bool checkTxBeforeSeal(bcos::protocol::Transaction::ConstPtr _tx, TxsHashSetPtr _avoidTxs);
+    // pop the unsealed system txs first, and the other txs from the sender lanes in round-robin
+    void batchFetchUnsealedTxs(bcos::protocol::Block::Ptr _txsList,
+        bcos::protocol::Block::Ptr _sysTxsList, size_t _txsLimit, TxsHashSetPtr _avoidTxs,
+        TxsConflictGroupsPtr _conflictGroups);
+    // reorder the txs in [_begin, end) to make the txs with the same conflict key contiguous
+    void groupByConflictKey(bcos::protocol::ConstTransactions& _txs, size_t _begin,
+        TxsConflictGroupsPtr _conflictGroups);
+    // fetch transactions from the whole table, including the sealed transactions, the scan
+    // resumes from the tx where the last scan stopped
+    void batchFetchAllTxs(bcos::protocol::Block::Ptr _txsList,
+        bcos::protocol::Block::Ptr _sysTxsList, size_t _txsLimit, TxsHashSetPtr _avoidTxs);
+    // append the fetched transaction into the proposal and mark it as sealed
+    void sealTxWithoutLock(bcos::protocol::Transaction::ConstPtr _tx,
+        bcos::protocol::Block::Ptr _txsList, bcos::protocol::Block::Ptr _sysTxsList);
+    // Note: x_unsealedTxs should be held by the caller
+    void insertUnsealedTxWithoutLock(bcos::protocol::Transaction::ConstPtr _tx);
+    void eraseUnsealedTxWithoutLock(bcos::protocol::Transaction::ConstPtr _tx);
+    // Note: x_unsealedTxs should be held by the caller
+    void updateSealedFlagWithoutLock(bcos::protocol::Transaction::ConstPtr _tx, bool _sealFlag);
+    // Note: x_unsealedTxs should be held by the caller, the sealed flag and the batch info are
+    // updated with the proposals referencing the tx
+    void referenceProposalWithoutLock(
+        bcos::protocol::Transaction::ConstPtr _tx, ProposalKey const& _proposal);
+    // set the batch info of the tx and its meta
+    void setBatchWithoutLock(bcos::protocol::Transaction::ConstPtr const& _tx,
+        bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash);
+    // return true if the tx is unsealed for no proposal references it
+    bool releaseProposalWithoutLock(
+        bcos::protocol::Transaction::ConstPtr _tx, ProposalKey const& _proposal);
+    // drop the references of the removed tx
+    void eraseProposalRefsWithoutLock(bcos::protocol::Transaction::ConstPtr _tx);
+    // Note: x_unsealedTxs should be held by the caller
+    size_t unsealProposalsWithoutLock(
+        ProposalTxsIndex::iterator _begin, ProposalTxsIndex::iterator _end);
 
 private:
     TxPoolConfig::Ptr m_config;
     ThreadPool::Ptr m_notifier;
-    ThreadPool::Ptr m_worker;
+    TxsPreCommitter::Ptr m_preCommitter;
+    UnsealedTxsNotifier::Ptr m_unsealedTxsSizeNotifier;
+
+    std::vector<TxsShard::Ptr> m_shards;
+    // Note: the hash is inserted into the filter before inserted into the table, and removed
+    // from the filter after removed from the table
+    CountingBloomFilter::Ptr m_txsFilter;
+    std::atomic<size_t> m_txsSize = {0};
+    std::atomic<uint64_t> m_memorySize = {0};
+    std::atomic<uint64_t> m_peakMemorySize = {0};
 
-    tbb::concurrent_unordered_map<bcos::crypto::HashType, bcos::protocol::Transaction::ConstPtr,
+    // the unsealed system txs, sealed before the other txs
+    // Note: insert is thread-safe under ReadGuard, erase must hold the WriteGuard
+    UnsealedTxsIndex m_unsealedSysTxs;
+    // the other unsealed txs grouped by sender, the sealer draws them in round-robin
+    // Note: insert is thread-safe under ReadGuard, erase and fetch must hold the WriteGuard
+    TxsSenderLanes::Ptr m_senderLanes;
+    mutable SharedMutex x_unsealedTxs;
+    // the sealed txs indexed by the in-flight proposals, and the proposals referencing every
+    // sealed tx, the tx is unsealed once all the proposals referencing it released
+    // Note: guarded by x_unsealedTxs
+    ProposalTxsIndex m_proposalTxs;
+    std::unordered_map<bcos::crypto::HashType, std::vector<ProposalKey>,
         std::hash<bcos::crypto::HashType>>
-        m_txsTable;
+        m_txProposals;
+    // the proposal of the txs fetched by the sealer but not marked
+    ProposalKey const c_fetchedProposal = ProposalKey(-1, bcos::crypto::HashType());
+    // select the unsealed txs to be evicted when the txpool is full, nullptr means reject
+    TxsEvictionPolicyInterface::Ptr m_evictionPolicy;
 
-    mutable SharedMutex x_txpoolMutex;
+    // the imported transactions that have not been broadcasted, appended by insert and drained
+    // by fetchNewTxs
+    tbb::concurrent_queue<bcos::protocol::Transaction::ConstPtr> m_newTxs;
 
     tbb::concurrent_set<bcos::crypto::HashType> m_invalidTxs;
     tbb::concurrent_set<bcos::protocol::NonceType> m_invalidNonces;
 
-    tbb::concurrent_set<bcos::crypto::HashType> m_missedTxs;
-    mutable SharedMutex x_missedTxs;
-    std::atomic<size_t> m_sealedTxsSize = {0};
+    // the txs requested from the peers, expire after missedTxsExpiration
+    MissedTxsTracker::Ptr m_missedTxs;
 
-    size_t c_maxRetryTime = 3;
+    // the transaction object, the table and index nodes and the shared_ptr control block
+    uint64_t c_txEntryOverhead = 512;
+    size_t c_maxEvictTimes = 16;
+    // the min results notified by a notifier task
+    size_t c_minNotifyChunkSize = 256;
 
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
     std::atomic_bool m_printed = {false};
     int64_t m_blockNumberUpdatedTime;
+    // decode => check => verify signature => check nonce and insert
+    // Note: declared last, the stage workers are stopped before the other members destroyed
+    TxsSubmitPipeline::Ptr m_submitPipeline;
 };
 }  // namespace txpool
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief track the missed txs requested from the peers
+ * @file MissedTxsTracker.cpp
+ * @author: yujiechen
+ * @date 2021-10-23
+ */
+#include "bcos-txpool/txpool/storage/MissedTxsTracker.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::crypto;
+
+MissedTxsTracker::MissedTxsTracker(uint64_t _expiration, size_t _capacity)
+  : m_generationInterval(std::max(_expiration / c_generationNum, (uint64_t)1)),
+    m_generationCapacity(std::max(_capacity / c_generationNum, (size_t)1)),
+    m_generations(c_generationNum),
+    m_currentStartTime(utcTime())
+{}
+
+void MissedTxsTracker::rotateWithoutLock(uint64_t _now)
+{
+    size_t rotateTimes = 0;
+    if (_now >= m_currentStartTime + m_generationInterval)
+    {
+        rotateTimes = (_now - m_currentStartTime) / m_generationInterval;
+        m_currentStartTime += rotateTimes * m_generationInterval;
+    }
+    else if (m_generations[m_current].size() >= m_generationCapacity)
+    {
+        // too many txs requested in this generation, drop the oldest generation in advance
+        rotateTimes = 1;
+        m_currentStartTime = _now;
+    }
+    rotateTimes = std::min(rotateTimes, c_generationNum);
+    for (size_t i = 0; i < rotateTimes; i++)
+    {
+        m_current = (m_current + 1) % c_generationNum;
+        m_generations[m_current].clear();
+    }
+}
+
+HashListPtr MissedTxsTracker::request(HashList const& _missedTxs, NodeIDPtr _peer)
+{
+    auto requestTxs = std::make_shared<HashList>();
+    auto now = utcTime();
+    Guard l(x_generations);
+    rotateWithoutLock(now);
+    auto& currentGeneration = m_generations[m_current];
+    for (auto const& txHash : _missedTxs)
+    {
+        bool requested = false;
+        for (auto& generation : m_generations)
+        {
+            auto it = generation.find(txHash);
+            if (it == generation.end())
+            {
+                continue;
+            }
+            // the requested peer has not responded for a generation, retry with another peer
+            auto const& missedTx = it->second;
+            if (missedTx.peer->data() != _peer->data() &&
+                now >= missedTx.requestTime + m_generationInterval)
+            {
+                generation.erase(it);
+                break;
+            }
+            requested = true;
+            break;
+        }
+        if (requested)
+        {
+            continue;
+        }
+        currentGeneration[txHash] = MissedTx{_peer, now};
+        requestTxs->emplace_back(txHash);
+    }
+    return requestTxs;
+}
+
+void MissedTxsTracker::removeWithoutLock(HashType const& _txHash)
+{
+    for (auto& generation : m_generations)
+    {
+        if (generation.erase(_txHash))
+        {
+            return;
+        }
+    }
+}
+
+void MissedTxsTracker::remove(HashType const& _txHash)
+{
+    Guard l(x_generations);
+    removeWithoutLock(_txHash);
+}
+
+void MissedTxsTracker::batchRemove(HashList const& _txsHash)
+{
+    Guard l(x_generations);
+    for (auto const& txHash : _txsHash)
+    {
+        removeWithoutLock(txHash);
+    }
+}
+
+void MissedTxsTracker::clear()
+{
+    Guard l(x_generations);
+    for (auto& generation : m_generations)
+    {
+        generation.clear();
+    }
+}
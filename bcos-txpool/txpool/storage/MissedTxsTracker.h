@@ -0,0 +1,72 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief track the missed txs requested from the peers
+ * @file MissedTxsTracker.h
+ * @author: yujiechen
+ * @date 2021-10-23
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace txpool
+{
+// The requested txs are recorded into a ring of generations, every generation covers
+// _expiration / c_generationNum ms, the oldest generation is dropped when the ring rotates,
+// so that the records expire gradually instead of being cleared all at once.
+class MissedTxsTracker
+{
+public:
+    using Ptr = std::shared_ptr<MissedTxsTracker>;
+    // _capacity: the max records, the ring rotates in advance once the current generation full
+    MissedTxsTracker(uint64_t _expiration, size_t _capacity);
+
+    // record and return the txs that should be requested from _peer, the tx requested recently
+    // is skipped, unless it has been requested from another peer for a generation
+    bcos::crypto::HashListPtr request(
+        bcos::crypto::HashList const& _missedTxs, bcos::crypto::NodeIDPtr _peer);
+
+    void remove(bcos::crypto::HashType const& _txHash);
+    void batchRemove(bcos::crypto::HashList const& _txsHash);
+    void clear();
+
+private:
+    struct MissedTx
+    {
+        bcos::crypto::NodeIDPtr peer;
+        uint64_t requestTime;
+    };
+    using Generation =
+        std::unordered_map<bcos::crypto::HashType, MissedTx, std::hash<bcos::crypto::HashType>>;
+
+    void rotateWithoutLock(uint64_t _now);
+    void removeWithoutLock(bcos::crypto::HashType const& _txHash);
+
+    static constexpr size_t c_generationNum = 4;
+
+    uint64_t m_generationInterval;
+    size_t m_generationCapacity;
+    std::vector<Generation> m_generations;
+    size_t m_current = 0;
+    uint64_t m_currentStartTime;
+    mutable Mutex x_generations;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,173 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief implementations of the txs eviction policy
+ * @file TxsEvictionPolicy.cpp
+ * @author: yujiechen
+ * @date 2021-10-19
+ */
+#include "bcos-txpool/txpool/storage/TxsEvictionPolicy.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+void ImportTimeEvictionPolicy::onInsert(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        return;
+    }
+    Guard l(x_txs);
+    m_txs.insert(_tx);
+}
+
+void ImportTimeEvictionPolicy::onRemove(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        return;
+    }
+    Guard l(x_txs);
+    m_txs.erase(_tx);
+}
+
+void ImportTimeEvictionPolicy::clear()
+{
+    Guard l(x_txs);
+    m_txs.clear();
+}
+
+Transaction::ConstPtr OldestFirstEvictionPolicy::selectVictim(Transaction::ConstPtr)
+{
+    Guard l(x_txs);
+    if (m_txs.empty())
+    {
+        return nullptr;
+    }
+    return *(m_txs.begin());
+}
+
+Transaction::ConstPtr LowestPriorityFirstEvictionPolicy::selectVictim(
+    Transaction::ConstPtr _incomingTx)
+{
+    // the newer normal transaction has lower priority than all the pending transactions
+    if (!_incomingTx->systemTx())
+    {
+        return nullptr;
+    }
+    Guard l(x_txs);
+    if (m_txs.empty())
+    {
+        return nullptr;
+    }
+    return *(m_txs.rbegin());
+}
+
+void SenderOverflowFirstEvictionPolicy::onInsert(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        return;
+    }
+    std::string sender(_tx->sender());
+    Guard l(x_senderToTxs);
+    auto& senderTxs = m_senderToTxs[sender];
+    auto originSize = senderTxs.size();
+    senderTxs.insert(_tx);
+    if (senderTxs.size() == originSize)
+    {
+        return;
+    }
+    m_senderSizes.erase(std::make_pair(originSize, sender));
+    m_senderSizes.insert(std::make_pair(senderTxs.size(), sender));
+}
+
+void SenderOverflowFirstEvictionPolicy::onRemove(Transaction::ConstPtr _tx)
+{
+    if (_tx->systemTx())
+    {
+        return;
+    }
+    std::string sender(_tx->sender());
+    Guard l(x_senderToTxs);
+    auto it = m_senderToTxs.find(sender);
+    if (it == m_senderToTxs.end())
+    {
+        return;
+    }
+    auto& senderTxs = it->second;
+    auto originSize = senderTxs.size();
+    if (!senderTxs.erase(_tx))
+    {
+        return;
+    }
+    m_senderSizes.erase(std::make_pair(originSize, sender));
+    if (senderTxs.empty())
+    {
+        m_senderToTxs.erase(it);
+        return;
+    }
+    m_senderSizes.insert(std::make_pair(senderTxs.size(), sender));
+}
+
+void SenderOverflowFirstEvictionPolicy::clear()
+{
+    Guard l(x_senderToTxs);
+    m_senderToTxs.clear();
+    m_senderSizes.clear();
+}
+
+Transaction::ConstPtr SenderOverflowFirstEvictionPolicy::selectVictim(
+    Transaction::ConstPtr _incomingTx)
+{
+    Guard l(x_senderToTxs);
+    if (m_senderSizes.empty())
+    {
+        return nullptr;
+    }
+    auto const& overflowSender = *(m_senderSizes.rbegin());
+    // only the system transactions and the transactions from the sender with fewer pending
+    // transactions can make room
+    if (!_incomingTx->systemTx())
+    {
+        size_t incomingSenderSize = 0;
+        auto it = m_senderToTxs.find(std::string(_incomingTx->sender()));
+        if (it != m_senderToTxs.end())
+        {
+            incomingSenderSize = it->second.size();
+        }
+        if (incomingSenderSize + 1 >= overflowSender.first)
+        {
+            return nullptr;
+        }
+    }
+    return *(m_senderToTxs[overflowSender.second].rbegin());
+}
+
+TxsEvictionPolicyInterface::Ptr bcos::txpool::createTxsEvictionPolicy(TxsEvictionPolicyType _type)
+{
+    switch (_type)
+    {
+    case TxsEvictionPolicyType::OldestFirst:
+        return std::make_shared<OldestFirstEvictionPolicy>();
+    case TxsEvictionPolicyType::LowestPriorityFirst:
+        return std::make_shared<LowestPriorityFirstEvictionPolicy>();
+    case TxsEvictionPolicyType::SenderOverflowFirst:
+        return std::make_shared<SenderOverflowFirstEvictionPolicy>();
+    default:
+        return nullptr;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief implementations of the txs eviction policy
+ * @file TxsEvictionPolicy.h
+ * @author: yujiechen
+ * @date 2021-10-19
+ */
+#pragma once
+#include "bcos-txpool/txpool/interfaces/TxsEvictionPolicyInterface.h"
+#include <bcos-framework/libutilities/Common.h>
+#include <map>
+#include <set>
+
+namespace bcos
+{
+namespace txpool
+{
+struct ImportTimeCompare
+{
+    bool operator()(bcos::protocol::Transaction::ConstPtr const& _first,
+        bcos::protocol::Transaction::ConstPtr const& _second) const
+    {
+        if (_first->importTime() != _second->importTime())
+        {
+            return _first->importTime() < _second->importTime();
+        }
+        return _first->hash() < _second->hash();
+    }
+};
+using ImportTimeOrderedTxs = std::set<bcos::protocol::Transaction::ConstPtr, ImportTimeCompare>;
+
+// track the non-system transactions ordered by the import time
+class ImportTimeEvictionPolicy : public TxsEvictionPolicyInterface
+{
+public:
+    ImportTimeEvictionPolicy() = default;
+    ~ImportTimeEvictionPolicy() override {}
+
+    void onInsert(bcos::protocol::Transaction::ConstPtr _tx) override;
+    void onRemove(bcos::protocol::Transaction::ConstPtr _tx) override;
+    void clear() override;
+
+protected:
+    ImportTimeOrderedTxs m_txs;
+    mutable Mutex x_txs;
+};
+
+// evict the oldest transaction for every incoming transaction
+class OldestFirstEvictionPolicy : public ImportTimeEvictionPolicy
+{
+public:
+    bcos::protocol::Transaction::ConstPtr selectVictim(
+        bcos::protocol::Transaction::ConstPtr _incomingTx) override;
+};
+
+// evict the newest transaction only for the incoming transaction with higher priority
+class LowestPriorityFirstEvictionPolicy : public ImportTimeEvictionPolicy
+{
+public:
+    bcos::protocol::Transaction::ConstPtr selectVictim(
+        bcos::protocol::Transaction::ConstPtr _incomingTx) override;
+};
+
+// evict the newest transaction of the sender with the most pending transactions
+class SenderOverflowFirstEvictionPolicy : public TxsEvictionPolicyInterface
+{
+public:
+    SenderOverflowFirstEvictionPolicy() = default;
+    ~SenderOverflowFirstEvictionPolicy() override {}
+
+    void onInsert(bcos::protocol::Transaction::ConstPtr _tx) override;
+    void onRemove(bcos::protocol::Transaction::ConstPtr _tx) override;
+    void clear() override;
+    bcos::protocol::Transaction::ConstPtr selectVictim(
+        bcos::protocol::Transaction::ConstPtr _incomingTx) override;
+
+private:
+    std::map<std::string, ImportTimeOrderedTxs> m_senderToTxs;
+    // the senders ordered by the pending txs size
+    std::set<std::pair<size_t, std::string>> m_senderSizes;
+    mutable Mutex x_senderToTxs;
+};
+
+TxsEvictionPolicyInterface::Ptr createTxsEvictionPolicy(TxsEvictionPolicyType _type);
+}  // namespace txpool
+}  // namespace bcos
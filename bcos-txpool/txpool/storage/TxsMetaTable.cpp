@@ -0,0 +1,162 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the hot fields of the pending txs in the structure-of-arrays layout
+ * @file TxsMetaTable.cpp
+ * @author: yujiechen
+ * @date 2021-10-25
+ */
+#include "bcos-txpool/txpool/storage/TxsMetaTable.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+TxsMetaTable::TxsMetaTable()
+{
+    m_batchHashes.emplace_back(HashType());
+    m_batchHashRefs.emplace_back(0);
+}
+
+void TxsMetaTable::insert(Transaction::ConstPtr const& _tx)
+{
+    if (!m_slots.emplace(_tx->hash(), (uint32_t)m_txs.size()).second)
+    {
+        return;
+    }
+    m_flags.emplace_back(_tx->sealed() ? c_sealedFlag : 0);
+    m_blockLimits.emplace_back(_tx->blockLimit());
+    m_batchIds.emplace_back(_tx->batchId());
+    m_batchHashIds.emplace_back(acquireBatchHashId(_tx->batchHash()));
+    m_hashes.emplace_back(_tx->hash());
+    m_txs.emplace_back(_tx);
+}
+
+void TxsMetaTable::erase(HashType const& _txHash)
+{
+    auto it = m_slots.find(_txHash);
+    if (it == m_slots.end())
+    {
+        return;
+    }
+    auto slot = it->second;
+    m_slots.erase(it);
+    releaseBatchHashId(m_batchHashIds[slot]);
+    // move the last slot into the erased one to keep the arrays dense
+    auto lastSlot = m_txs.size() - 1;
+    if (slot != lastSlot)
+    {
+        m_flags[slot] = m_flags[lastSlot];
+        m_blockLimits[slot] = m_blockLimits[lastSlot];
+        m_batchIds[slot] = m_batchIds[lastSlot];
+        m_batchHashIds[slot] = m_batchHashIds[lastSlot];
+        m_hashes[slot] = m_hashes[lastSlot];
+        m_txs[slot] = std::move(m_txs[lastSlot]);
+        m_slots[m_hashes[slot]] = slot;
+        m_movedCount++;
+    }
+    m_flags.pop_back();
+    m_blockLimits.pop_back();
+    m_batchIds.pop_back();
+    m_batchHashIds.pop_back();
+    m_hashes.pop_back();
+    m_txs.pop_back();
+}
+
+void TxsMetaTable::clear()
+{
+    m_slots.clear();
+    m_flags.clear();
+    m_blockLimits.clear();
+    m_batchIds.clear();
+    m_batchHashIds.clear();
+    m_hashes.clear();
+    m_txs.clear();
+    m_movedCount++;
+    m_batchHashes.resize(1);
+    m_batchHashRefs.resize(1);
+    m_freeBatchHashIds.clear();
+    m_batchHashToId.clear();
+}
+
+void TxsMetaTable::setSealed(HashType const& _txHash, bool _sealed)
+{
+    auto it = m_slots.find(_txHash);
+    if (it == m_slots.end())
+    {
+        return;
+    }
+    auto& flags = m_flags[it->second];
+    flags = _sealed ? (flags | c_sealedFlag) : (flags & ~c_sealedFlag);
+}
+
+void TxsMetaTable::setBatch(HashType const& _txHash, BlockNumber _batchId, HashType const& _batchHash)
+{
+    auto it = m_slots.find(_txHash);
+    if (it == m_slots.end())
+    {
+        return;
+    }
+    auto slot = it->second;
+    m_batchIds[slot] = _batchId;
+    if (m_batchHashes[m_batchHashIds[slot]] == _batchHash)
+    {
+        return;
+    }
+    releaseBatchHashId(m_batchHashIds[slot]);
+    m_batchHashIds[slot] = acquireBatchHashId(_batchHash);
+}
+
+uint32_t TxsMetaTable::acquireBatchHashId(HashType const& _batchHash)
+{
+    if (_batchHash == HashType())
+    {
+        return 0;
+    }
+    auto it = m_batchHashToId.find(_batchHash);
+    if (it != m_batchHashToId.end())
+    {
+        m_batchHashRefs[it->second]++;
+        return it->second;
+    }
+    uint32_t batchHashId;
+    if (m_freeBatchHashIds.empty())
+    {
+        batchHashId = m_batchHashes.size();
+        m_batchHashes.emplace_back(_batchHash);
+        m_batchHashRefs.emplace_back(1);
+    }
+    else
+    {
+        batchHashId = m_freeBatchHashIds.back();
+        m_freeBatchHashIds.pop_back();
+        m_batchHashes[batchHashId] = _batchHash;
+        m_batchHashRefs[batchHashId] = 1;
+    }
+    m_batchHashToId[_batchHash] = batchHashId;
+    return batchHashId;
+}
+
+void TxsMetaTable::releaseBatchHashId(uint32_t _batchHashId)
+{
+    if (_batchHashId == 0 || --m_batchHashRefs[_batchHashId] > 0)
+    {
+        return;
+    }
+    m_batchHashToId.erase(m_batchHashes[_batchHashId]);
+    m_batchHashes[_batchHashId] = HashType();
+    m_freeBatchHashIds.emplace_back(_batchHashId);
+}
@@ -0,0 +1,93 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the hot fields of the pending txs in the structure-of-arrays layout
+ * @file TxsMetaTable.h
+ * @author: yujiechen
+ * @date 2021-10-25
+ */
+#pragma once
+#include "bcos-txpool/txpool/utilities/SwissHashTable.h"
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace txpool
+{
+// The fields read by the scans over a shard are kept in the slot-indexed arrays, so that the
+// scans touch the contiguous memory, and dereference the txs only when selected. The batch
+// hashes are shared by the txs of a proposal, every slot keeps the id of its batch hash, while
+// the tx hashes are kept in full. Every slot holds another reference of the tx in the txs table.
+// Note: the slots are inserted and erased under the shard WriteGuard and x_unsealedTxs, the
+// fields are modified under the WriteGuard of x_unsealedTxs; erase moves the last slot
+class TxsMetaTable
+{
+public:
+    TxsMetaTable();
+
+    void insert(bcos::protocol::Transaction::ConstPtr const& _tx);
+    void erase(bcos::crypto::HashType const& _txHash);
+    void clear();
+
+    void setSealed(bcos::crypto::HashType const& _txHash, bool _sealed);
+    void setBatch(bcos::crypto::HashType const& _txHash, bcos::protocol::BlockNumber _batchId,
+        bcos::crypto::HashType const& _batchHash);
+
+    size_t size() const { return m_txs.size(); }
+    // return size() if not found
+    size_t slot(bcos::crypto::HashType const& _txHash) const
+    {
+        auto it = m_slots.find(_txHash);
+        return it == m_slots.end() ? size() : it->second;
+    }
+    // increased once a slot moved by erase
+    uint64_t movedCount() const { return m_movedCount; }
+
+    bool sealed(size_t _slot) const { return m_flags[_slot] & c_sealedFlag; }
+    bcos::protocol::BlockNumber blockLimit(size_t _slot) const { return m_blockLimits[_slot]; }
+    bcos::protocol::BlockNumber batchId(size_t _slot) const { return m_batchIds[_slot]; }
+    bcos::crypto::HashType const& batchHash(size_t _slot) const
+    {
+        return m_batchHashes[m_batchHashIds[_slot]];
+    }
+    bcos::crypto::HashType const& hash(size_t _slot) const { return m_hashes[_slot]; }
+    bcos::protocol::Transaction::ConstPtr const& tx(size_t _slot) const { return m_txs[_slot]; }
+
+private:
+    uint32_t acquireBatchHashId(bcos::crypto::HashType const& _batchHash);
+    void releaseBatchHashId(uint32_t _batchHashId);
+
+    static constexpr uint8_t c_sealedFlag = 0x01;
+
+    SwissHashTable<uint32_t> m_slots;
+    std::vector<uint8_t> m_flags;
+    std::vector<bcos::protocol::BlockNumber> m_blockLimits;
+    std::vector<bcos::protocol::BlockNumber> m_batchIds;
+    std::vector<uint32_t> m_batchHashIds;
+    std::vector<bcos::crypto::HashType> m_hashes;
+    std::vector<bcos::protocol::Transaction::ConstPtr> m_txs;
+    uint64_t m_movedCount = 0;
+
+    // batch hash id => (batch hash, referenced times), the id 0 is the empty hash
+    std::vector<bcos::crypto::HashType> m_batchHashes;
+    std::vector<uint32_t> m_batchHashRefs;
+    std::vector<uint32_t> m_freeBatchHashIds;
+    std::unordered_map<bcos::crypto::HashType, uint32_t, std::hash<bcos::crypto::HashType>>
+        m_batchHashToId;
+};
+}  // namespace txpool
+}  // namespace bcos
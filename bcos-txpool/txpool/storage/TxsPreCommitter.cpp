@@ -0,0 +1,184 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief write-behind batcher that stores the imported transactions into the ledger
+ * @file TxsPreCommitter.cpp
+ * @author: yujiechen
+ * @date 2021-10-18
+ */
+#include "bcos-txpool/txpool/storage/TxsPreCommitter.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+void TxsPreCommitter::start()
+{
+    startWorking();
+}
+
+void TxsPreCommitter::stop()
+{
+    finishWorker();
+    {
+        // wake up the worker waiting for the interval
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        m_stopping = true;
+        m_signalled.notify_all();
+    }
+    stopWorking();
+    // will not restart worker, so terminate it
+    terminate();
+    // store the remaining transactions, and retry the failed batches once without backoff
+    flushPendingTxs();
+    TxsBatch::Ptr batch;
+    std::vector<TxsBatch::Ptr> failedBatches;
+    while (m_failedBatches.try_pop(batch))
+    {
+        failedBatches.emplace_back(batch);
+    }
+    // the batches failed from now on are dropped
+    m_drained = true;
+    for (auto const& failedBatch : failedBatches)
+    {
+        storeBatch(failedBatch);
+    }
+}
+
+void TxsPreCommitter::append(Transaction::ConstPtr _tx)
+{
+    m_pendingTxs.push(_tx);
+    if (m_pendingTxs.unsafe_size() >= m_batchSize)
+    {
+        // Note: notify with the lock held, so that the worker never misses the wakeup between
+        // its check and its wait
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        m_signalled.notify_all();
+    }
+}
+
+void TxsPreCommitter::executeWorker()
+{
+    retryFailedBatches();
+    if (m_pendingTxs.unsafe_size() >= m_batchSize ||
+        (utcTime() - m_lastFlushTime) >= m_intervalMs)
+    {
+        flushPendingTxs();
+    }
+    boost::unique_lock<boost::mutex> l(x_signalled);
+    if (m_stopping || m_pendingTxs.unsafe_size() >= m_batchSize)
+    {
+        return;
+    }
+    // the failed batches are retried after the backoff
+    auto waitTime =
+        m_failedBatches.empty() ? m_intervalMs : std::min(m_intervalMs, c_retryBackoffMs);
+    m_signalled.wait_for(l, boost::chrono::milliseconds(waitTime));
+}
+
+void TxsPreCommitter::flushPendingTxs()
+{
+    m_lastFlushTime = utcTime();
+    while (!m_pendingTxs.empty())
+    {
+        auto batch = std::make_shared<TxsBatch>();
+        Transaction::ConstPtr tx;
+        while (batch->txsHash->size() < m_batchSize && m_pendingTxs.try_pop(tx))
+        {
+            try
+            {
+                auto encodedData = tx->encode(false);
+                batch->txsToStore->emplace_back(
+                    std::make_shared<bytes>(encodedData.begin(), encodedData.end()));
+                batch->txsHash->emplace_back(tx->hash());
+            }
+            catch (std::exception const& e)
+            {
+                TXPOOL_LOG(WARNING) << LOG_DESC("preCommitTransaction exception")
+                                    << LOG_KV("error", boost::diagnostic_information(e))
+                                    << LOG_KV("tx", tx->hash().abridged());
+            }
+        }
+        if (batch->txsHash->empty())
+        {
+            return;
+        }
+        storeBatch(batch);
+    }
+}
+
+void TxsPreCommitter::retryFailedBatches()
+{
+    if (m_failedBatches.empty())
+    {
+        return;
+    }
+    std::vector<TxsBatch::Ptr> delayedBatches;
+    auto currentTime = utcTime();
+    TxsBatch::Ptr batch;
+    while (m_failedBatches.try_pop(batch))
+    {
+        if (batch->retryAfter > currentTime)
+        {
+            delayedBatches.emplace_back(batch);
+            continue;
+        }
+        storeBatch(batch);
+    }
+    for (auto const& delayedBatch : delayedBatches)
+    {
+        m_failedBatches.push(delayedBatch);
+    }
+}
+
+void TxsPreCommitter::storeBatch(TxsBatch::Ptr _batch)
+{
+    auto self = std::weak_ptr<TxsPreCommitter>(shared_from_this());
+    m_config->ledger()->asyncStoreTransactions(
+        _batch->txsToStore, _batch->txsHash, [self, _batch](Error::Ptr _error) {
+            if (_error == nullptr)
+            {
+                return;
+            }
+            auto preCommitter = self.lock();
+            if (!preCommitter)
+            {
+                return;
+            }
+            preCommitter->onStoreFailed(_batch, _error);
+        });
+}
+
+void TxsPreCommitter::onStoreFailed(TxsBatch::Ptr _batch, Error::Ptr _error)
+{
+    TXPOOL_LOG(WARNING) << LOG_DESC("asyncPreStoreTransaction failed")
+                        << LOG_KV("errorCode", _error->errorCode())
+                        << LOG_KV("errorMsg", _error->errorMessage())
+                        << LOG_KV("txsSize", _batch->txsHash->size())
+                        << LOG_KV("retryTime", _batch->retryTime);
+    if (_batch->retryTime >= c_maxRetryTime || m_drained)
+    {
+        TXPOOL_LOG(ERROR) << LOG_DESC("drop the txs batch failed to be stored")
+                          << LOG_KV("txsSize", _batch->txsHash->size())
+                          << LOG_KV("retryTime", _batch->retryTime)
+                          << LOG_KV("stopped", m_drained.load());
+        return;
+    }
+    _batch->retryTime++;
+    // Note: never block the callback thread, the batch is retried by the worker later
+    _batch->retryAfter = utcTime() + c_retryBackoffMs * _batch->retryTime;
+    m_failedBatches.push(_batch);
+}
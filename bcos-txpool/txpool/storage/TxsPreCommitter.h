@@ -0,0 +1,95 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief write-behind batcher that stores the imported transactions into the ledger
+ * @file TxsPreCommitter.h
+ * @author: yujiechen
+ * @date 2021-10-18
+ */
+#pragma once
+#include "bcos-txpool/TxPoolConfig.h"
+#include <bcos-framework/libutilities/Worker.h>
+#include <tbb/concurrent_queue.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace bcos
+{
+namespace txpool
+{
+// collect the imported transactions for up to batchSize items or interval milliseconds, and
+// store them into the ledger with one asyncStoreTransactions call
+class TxsPreCommitter : public Worker, public std::enable_shared_from_this<TxsPreCommitter>
+{
+public:
+    using Ptr = std::shared_ptr<TxsPreCommitter>;
+    TxsPreCommitter(TxPoolConfig::Ptr _config, size_t _batchSize, uint64_t _intervalMs)
+      : Worker("txsPreCommitter", 0),
+        m_config(std::move(_config)),
+        m_batchSize(std::max(_batchSize, (size_t)1)),
+        m_intervalMs(std::max(_intervalMs, (uint64_t)1))
+    {
+        m_lastFlushTime = utcTime();
+    }
+    ~TxsPreCommitter() override {}
+
+    virtual void start();
+    virtual void stop();
+
+    virtual void append(bcos::protocol::Transaction::ConstPtr _tx);
+    size_t pendingSize() const { return m_pendingTxs.unsafe_size(); }
+
+protected:
+    struct TxsBatch
+    {
+        using Ptr = std::shared_ptr<TxsBatch>;
+        std::shared_ptr<std::vector<bytesConstPtr>> txsToStore =
+            std::make_shared<std::vector<bytesConstPtr>>();
+        bcos::crypto::HashListPtr txsHash = std::make_shared<bcos::crypto::HashList>();
+        size_t retryTime = 0;
+        // the failed batch will not be retried before this time
+        uint64_t retryAfter = 0;
+    };
+
+    void executeWorker() override;
+
+    virtual void flushPendingTxs();
+    virtual void retryFailedBatches();
+    virtual void storeBatch(TxsBatch::Ptr _batch);
+    virtual void onStoreFailed(TxsBatch::Ptr _batch, Error::Ptr _error);
+
+private:
+    TxPoolConfig::Ptr m_config;
+    size_t m_batchSize;
+    uint64_t m_intervalMs;
+    uint64_t m_lastFlushTime;
+
+    tbb::concurrent_queue<bcos::protocol::Transaction::ConstPtr> m_pendingTxs;
+    tbb::concurrent_queue<TxsBatch::Ptr> m_failedBatches;
+
+    size_t c_maxRetryTime = 3;
+    uint64_t c_retryBackoffMs = 100;
+
+    // set when stopping under x_signalled, the worker never waits for the interval again
+    bool m_stopping = false;
+    // set once the failed batches drained at stop, the batches failed later are dropped
+    std::atomic_bool m_drained = {false};
+
+    boost::condition_variable m_signalled;
+    // mutex to access m_signalled
+    boost::mutex x_signalled;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,122 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the unsealed transactions grouped by sender
+ * @file TxsSenderLanes.cpp
+ * @author: yujiechen
+ * @date 2021-10-26
+ */
+#include "bcos-txpool/txpool/storage/TxsSenderLanes.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+void TxsSenderLanes::insert(Transaction::ConstPtr _tx)
+{
+    std::string sender(_tx->sender());
+    Guard l(x_lanes);
+    m_lanes[sender].insert(_tx);
+}
+
+void TxsSenderLanes::erase(Transaction::ConstPtr _tx)
+{
+    std::string sender(_tx->sender());
+    auto it = m_lanes.find(sender);
+    if (it == m_lanes.end())
+    {
+        return;
+    }
+    it->second.erase(_tx);
+    if (it->second.empty())
+    {
+        m_lanes.erase(it);
+    }
+}
+
+void TxsSenderLanes::clear()
+{
+    m_lanes.clear();
+    m_lastSender.clear();
+}
+
+ConstTransactions TxsSenderLanes::fetch(size_t _txsLimit, size_t _senderLimit,
+    std::function<bool(Transaction::ConstPtr const&)> const& _filter)
+{
+    struct LaneCursor
+    {
+        std::string const* sender;
+        Lane::const_iterator current;
+        Lane::const_iterator end;
+        size_t fetchedSize;
+    };
+    ConstTransactions fetchedTxs;
+    if (_txsLimit == 0 || m_lanes.empty())
+    {
+        return fetchedTxs;
+    }
+    // take the next tx passed the filter from the lane, return false once the lane exhausted or
+    // the sender limit reached
+    auto fetchFromLane = [&](LaneCursor& _cursor) {
+        while (_cursor.current != _cursor.end && !_filter(*_cursor.current))
+        {
+            _cursor.current++;
+        }
+        if (_cursor.current == _cursor.end)
+        {
+            return false;
+        }
+        fetchedTxs.emplace_back(*_cursor.current);
+        _cursor.current++;
+        _cursor.fetchedSize++;
+        m_lastSender = *_cursor.sender;
+        return _cursor.current != _cursor.end &&
+               (_senderLimit == 0 || _cursor.fetchedSize < _senderLimit);
+    };
+    // the first round visits the lanes from the one after the last visited lane, the cursors are
+    // created lazily, so the lanes beyond the limit are never touched
+    std::vector<LaneCursor> cursors;
+    auto lane = m_lanes.upper_bound(m_lastSender);
+    for (size_t i = 0; i < m_lanes.size() && fetchedTxs.size() < _txsLimit; i++, lane++)
+    {
+        if (lane == m_lanes.end())
+        {
+            lane = m_lanes.begin();
+        }
+        LaneCursor cursor{&lane->first, lane->second.begin(), lane->second.end(), 0};
+        if (fetchFromLane(cursor))
+        {
+            cursors.emplace_back(cursor);
+        }
+    }
+    // the following rounds take one tx from every active lane, drop the inactive lanes
+    while (fetchedTxs.size() < _txsLimit && !cursors.empty())
+    {
+        size_t activeSize = 0;
+        for (auto& cursor : cursors)
+        {
+            if (fetchedTxs.size() >= _txsLimit)
+            {
+                break;
+            }
+            if (fetchFromLane(cursor))
+            {
+                cursors[activeSize++] = cursor;
+            }
+        }
+        cursors.resize(activeSize);
+    }
+    return fetchedTxs;
+}
@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the unsealed transactions grouped by sender
+ * @file TxsSenderLanes.h
+ * @author: yujiechen
+ * @date 2021-10-26
+ */
+#pragma once
+#include "bcos-txpool/txpool/utilities/SlabAllocator.h"
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <map>
+#include <set>
+
+namespace bcos
+{
+namespace txpool
+{
+struct TransactionCompare
+{
+    bool operator()(bcos::protocol::Transaction::ConstPtr const& _first,
+        bcos::protocol::Transaction::ConstPtr const& _second) const
+    {
+        // high priority for system transactions
+        if (_first->systemTx() != _second->systemTx())
+        {
+            return _first->systemTx();
+        }
+        // sort by importTime in ascending order
+        if (_first->importTime() != _second->importTime())
+        {
+            return _first->importTime() < _second->importTime();
+        }
+        // Note: the ordered index requires strict weak ordering, distinguish the transactions
+        // imported at the same time by hash
+        return _first->hash() < _second->hash();
+    }
+};
+
+// every sender has a lane of its unsealed txs ordered by priority, the sealer draws the txs
+// from the lanes in round-robin, so that a flooding sender can not starve the others
+// Note: insert can be called concurrently, erase, clear and fetch must be exclusive with all
+// the other operations, the txpool calls them under the WriteGuard of x_unsealedTxs
+class TxsSenderLanes
+{
+public:
+    using Ptr = std::shared_ptr<TxsSenderLanes>;
+    TxsSenderLanes() = default;
+
+    void insert(bcos::protocol::Transaction::ConstPtr _tx);
+    void erase(bcos::protocol::Transaction::ConstPtr _tx);
+    void clear();
+
+    // fetch at most _txsLimit txs passed _filter, and at most _senderLimit txs of every
+    // sender(0 means no limit), the lanes are visited from the one after the last visited lane
+    bcos::protocol::ConstTransactions fetch(size_t _txsLimit, size_t _senderLimit,
+        std::function<bool(bcos::protocol::Transaction::ConstPtr const&)> const& _filter);
+
+private:
+    using Lane = std::set<bcos::protocol::Transaction::ConstPtr, TransactionCompare,
+        SlabAllocator<bcos::protocol::Transaction::ConstPtr>>;
+    std::map<std::string, Lane> m_lanes;
+    // the sender of the last fetched tx
+    std::string m_lastSender;
+    // serialize the concurrent inserts
+    Mutex x_lanes;
+};
+}  // namespace txpool
+}  // namespace bcos
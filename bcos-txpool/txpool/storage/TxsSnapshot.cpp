@@ -0,0 +1,233 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief snapshot the pending transactions into the local file for warm restart
+ * @file TxsSnapshot.cpp
+ * @author: yujiechen
+ * @date 2021-10-21
+ */
+#include "bcos-txpool/txpool/storage/TxsSnapshot.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace
+{
+template <typename T>
+void writeInteger(std::ostream& _out, T _value)
+{
+    uint8_t buffer[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        buffer[i] = (uint8_t)(_value >> (8 * i));
+    }
+    _out.write((char const*)buffer, sizeof(T));
+}
+
+template <typename T>
+bool readInteger(std::istream& _in, T& _value)
+{
+    uint8_t buffer[sizeof(T)];
+    if (!_in.read((char*)buffer, sizeof(T)))
+    {
+        return false;
+    }
+    _value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        _value |= ((T)buffer[i] << (8 * i));
+    }
+    return true;
+}
+
+// flush the file or the directory to the disk
+bool syncToDisk(std::string const& _path, int _flags)
+{
+    auto fd = ::open(_path.c_str(), _flags);
+    if (fd < 0)
+    {
+        return false;
+    }
+    auto ret = ::fsync(fd);
+    ::close(fd);
+    return ret == 0;
+}
+
+std::string parentDir(std::string const& _path)
+{
+    auto pos = _path.find_last_of('/');
+    if (pos == std::string::npos)
+    {
+        return ".";
+    }
+    return pos == 0 ? "/" : _path.substr(0, pos);
+}
+}  // namespace
+
+void TxsSnapshot::start()
+{
+    if (m_running)
+    {
+        return;
+    }
+    m_running = true;
+    startWorking();
+}
+
+void TxsSnapshot::stop()
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    {
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        m_stopped = true;
+    }
+    m_signalled.notify_all();
+    finishWorker();
+    stopWorking();
+    // will not restart worker, so terminate it
+    terminate();
+    snapshot();
+}
+
+void TxsSnapshot::executeWorker()
+{
+    {
+        boost::unique_lock<boost::mutex> l(x_signalled);
+        if (m_signalled.wait_for(l, boost::chrono::milliseconds(m_intervalMs),
+                [this]() { return m_stopped; }))
+        {
+            return;
+        }
+    }
+    snapshot();
+}
+
+void TxsSnapshot::snapshot()
+{
+    try
+    {
+        auto txs = m_fetchTxs();
+        store(*txs);
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs exception")
+                            << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
+bool TxsSnapshot::store(ConstTransactions const& _txs)
+{
+    auto startT = utcTime();
+    auto tmpPath = m_path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs failed for open file failed")
+                                << LOG_KV("path", tmpPath);
+            return false;
+        }
+        writeInteger(out, c_magic);
+        writeInteger(out, c_version);
+        writeInteger(out, (uint64_t)_txs.size());
+        for (auto const& tx : _txs)
+        {
+            auto encodedData = tx->encode(false);
+            writeInteger(out, (uint32_t)encodedData.size());
+            out.write((char const*)encodedData.data(), encodedData.size());
+        }
+        out.flush();
+        if (!out)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs failed for write file failed")
+                                << LOG_KV("path", tmpPath);
+            return false;
+        }
+    }
+    // the data must be on the disk before renamed, otherwise the crash may leave the renamed
+    // snapshot empty
+    if (!syncToDisk(tmpPath, O_RDONLY))
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs failed for sync file failed")
+                            << LOG_KV("path", tmpPath);
+        return false;
+    }
+    if (std::rename(tmpPath.c_str(), m_path.c_str()) != 0)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs failed for rename file failed")
+                            << LOG_KV("path", m_path);
+        return false;
+    }
+    // persist the rename
+    if (!syncToDisk(parentDir(m_path), O_RDONLY | O_DIRECTORY))
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("snapshot txs: sync the directory failed")
+                            << LOG_KV("path", m_path);
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("snapshot txs success") << LOG_KV("txsSize", _txs.size())
+                     << LOG_KV("path", m_path) << LOG_KV("timecost", (utcTime() - startT));
+    return true;
+}
+
+std::shared_ptr<std::vector<bytesPointer>> TxsSnapshot::load()
+{
+    auto encodedTxs = std::make_shared<std::vector<bytesPointer>>();
+    std::ifstream in(m_path, std::ios::binary);
+    if (!in)
+    {
+        TXPOOL_LOG(INFO) << LOG_DESC("no txs snapshot") << LOG_KV("path", m_path);
+        return encodedTxs;
+    }
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t txsSize = 0;
+    if (!readInteger(in, magic) || !readInteger(in, version) || !readInteger(in, txsSize) ||
+        magic != c_magic || version != c_version)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("load txs snapshot failed for invalid header")
+                            << LOG_KV("path", m_path);
+        return encodedTxs;
+    }
+    for (uint64_t i = 0; i < txsSize; i++)
+    {
+        uint32_t txSize = 0;
+        if (!readInteger(in, txSize) || txSize > c_maxTxSize)
+        {
+            break;
+        }
+        auto encodedTx = std::make_shared<bytes>(txSize);
+        if (!in.read((char*)encodedTx->data(), txSize))
+        {
+            break;
+        }
+        encodedTxs->emplace_back(encodedTx);
+    }
+    if (encodedTxs->size() != txsSize)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("load txs snapshot: truncated snapshot")
+                            << LOG_KV("expected", txsSize) << LOG_KV("loaded", encodedTxs->size());
+    }
+    return encodedTxs;
+}
@@ -0,0 +1,80 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief snapshot the pending transactions into the local file for warm restart
+ * @file TxsSnapshot.h
+ * @author: yujiechen
+ * @date 2021-10-21
+ */
+#pragma once
+#include "bcos-txpool/txpool/interfaces/TxPoolStorageInterface.h"
+#include <bcos-framework/libutilities/Worker.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace bcos
+{
+namespace txpool
+{
+// The snapshot file is made up of the header(magic, version, txs count) and the
+// length-prefixed encoded transactions, all the integers are little-endian.
+// Note: the snapshot is written into a temporary file, synced to the disk and renamed to the
+// snapshot path, so the crash during writing never corrupts the last snapshot
+class TxsSnapshot : public Worker, public std::enable_shared_from_this<TxsSnapshot>
+{
+public:
+    using Ptr = std::shared_ptr<TxsSnapshot>;
+    TxsSnapshot(std::string const& _path, uint64_t _intervalMs,
+        std::function<bcos::protocol::ConstTransactionsPtr()> _fetchTxs)
+      : Worker("txsSnapshot", 0),
+        m_path(_path),
+        m_intervalMs(std::max(_intervalMs, (uint64_t)1)),
+        m_fetchTxs(std::move(_fetchTxs))
+    {}
+    ~TxsSnapshot() override {}
+
+    // snapshot the pending txs periodically
+    virtual void start();
+    // stop the periodic snapshot and snapshot the pending txs for the last time
+    virtual void stop();
+
+    virtual bool store(bcos::protocol::ConstTransactions const& _txs);
+    // load the encoded txs from the snapshot file, return empty list if no valid snapshot
+    virtual std::shared_ptr<std::vector<bytesPointer>> load();
+
+    std::string const& path() const { return m_path; }
+
+protected:
+    void executeWorker() override;
+    virtual void snapshot();
+
+private:
+    std::string m_path;
+    uint64_t m_intervalMs;
+    std::function<bcos::protocol::ConstTransactionsPtr()> m_fetchTxs;
+    std::atomic_bool m_running = {false};
+
+    static constexpr uint32_t c_magic = 0x53505854;  // "TXPS"
+    static constexpr uint32_t c_version = 1;
+    // the max size of the encoded transaction, in case of loading the corrupted file
+    static constexpr uint32_t c_maxTxSize = 32 * 1024 * 1024;
+
+    bool m_stopped = false;
+    boost::condition_variable m_signalled;
+    // mutex to access m_signalled and m_stopped
+    boost::mutex x_signalled;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,138 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the staged pipeline of the submitted txs with the bounded queues
+ * @file TxsSubmitPipeline.cpp
+ * @author: yujiechen
+ * @date 2021-10-27
+ */
+#include "bcos-txpool/txpool/storage/TxsSubmitPipeline.h"
+#include <bcos-framework/interfaces/txpool/TxPoolTypeDef.h>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+void TxsSubmitPipeline::appendStage(
+    std::string const& _name, size_t _workerNum, size_t _capacity, StageHandler _handler)
+{
+    auto stage = std::make_unique<Stage>();
+    stage->name = _name;
+    stage->capacity = std::max(_capacity, (size_t)1);
+    stage->handler = std::move(_handler);
+    stage->workers = std::make_shared<ThreadPool>(_name, std::max(_workerNum, (size_t)1));
+    m_stages.emplace_back(std::move(stage));
+}
+
+TransactionStatus TxsSubmitPipeline::submit(TxSubmitTask::Ptr _task)
+{
+    if (!enqueue(0, _task))
+    {
+        return TransactionStatus::TxPoolIsFull;
+    }
+    return TransactionStatus::None;
+}
+
+void TxsSubmitPipeline::stop()
+{
+    for (auto const& stage : m_stages)
+    {
+        stage->workers->stop();
+    }
+}
+
+bool TxsSubmitPipeline::enqueue(size_t _stageIndex, TxSubmitTask::Ptr const& _task)
+{
+    auto& stage = *m_stages[_stageIndex];
+    // reserve the room before enqueued, never exceed the capacity under the concurrent producers
+    if (stage.depth.fetch_add(1) >= stage.capacity)
+    {
+        stage.depth--;
+        stage.rejectedCount++;
+        reject(*_task, TransactionStatus::TxPoolIsFull);
+        tryToReportMetrics();
+        return false;
+    }
+    stage.workers->enqueue([this, _stageIndex, _task]() { handle(_stageIndex, _task); });
+    return true;
+}
+
+void TxsSubmitPipeline::handle(size_t _stageIndex, TxSubmitTask::Ptr const& _task)
+{
+    auto& stage = *m_stages[_stageIndex];
+    TransactionStatus status;
+    try
+    {
+        status = stage.handler(*_task);
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxsSubmitPipeline: handle exception")
+                            << LOG_KV("stage", stage.name)
+                            << LOG_KV("error", boost::diagnostic_information(e));
+        status = TransactionStatus::Malform;
+    }
+    stage.depth--;
+    stage.processedCount++;
+    if (status != TransactionStatus::None)
+    {
+        reject(*_task, status);
+        return;
+    }
+    if (_stageIndex + 1 < m_stages.size())
+    {
+        enqueue(_stageIndex + 1, _task);
+    }
+}
+
+void TxsSubmitPipeline::reject(TxSubmitTask const& _task, TransactionStatus _status)
+{
+    if (m_onRejected)
+    {
+        m_onRejected(_task, _status);
+    }
+}
+
+std::vector<TxsSubmitStageMetrics> TxsSubmitPipeline::metrics() const
+{
+    std::vector<TxsSubmitStageMetrics> stagesMetrics;
+    for (auto const& stage : m_stages)
+    {
+        stagesMetrics.emplace_back(TxsSubmitStageMetrics{stage->name, stage->depth.load(),
+            stage->capacity, stage->processedCount.load(), stage->rejectedCount.load()});
+    }
+    return stagesMetrics;
+}
+
+void TxsSubmitPipeline::tryToReportMetrics()
+{
+    // report at most once every interval while shedding the load
+    auto now = utcTime();
+    auto lastReportTime = m_lastReportTime.load();
+    if (now < lastReportTime + c_reportInterval ||
+        !m_lastReportTime.compare_exchange_strong(lastReportTime, now))
+    {
+        return;
+    }
+    for (auto const& stageMetrics : metrics())
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxsSubmitPipeline: shedding the submitted txs")
+                            << LOG_KV("stage", stageMetrics.name)
+                            << LOG_KV("depth", stageMetrics.depth)
+                            << LOG_KV("capacity", stageMetrics.capacity)
+                            << LOG_KV("processed", stageMetrics.processedCount)
+                            << LOG_KV("rejected", stageMetrics.rejectedCount);
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the staged pipeline of the submitted txs with the bounded queues
+ * @file TxsSubmitPipeline.h
+ * @author: yujiechen
+ * @date 2021-10-27
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <bcos-framework/libprotocol/TransactionStatus.h>
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace bcos
+{
+namespace txpool
+{
+// the submitted tx flowing through the stages
+struct TxSubmitTask
+{
+    using Ptr = std::shared_ptr<TxSubmitTask>;
+    bytesPointer txData;
+    // decoded by the first stage
+    bcos::protocol::Transaction::Ptr tx;
+    bcos::protocol::TxSubmitCallback submitCallback;
+    // whether the node is in the group, checked by the first stage
+    std::function<bool()> inGroup;
+};
+
+struct TxsSubmitStageMetrics
+{
+    std::string name;
+    // the tasks queued or in handling
+    size_t depth;
+    size_t capacity;
+    uint64_t processedCount;
+    // the tasks shed for the full queue
+    uint64_t rejectedCount;
+};
+
+// The submission is split into the stages, every stage has its own workers and a bounded queue.
+// The task is rejected with TxPoolIsFull once the queue of the stage is full, so the overload is
+// shed instead of piling up in the memory.
+class TxsSubmitPipeline
+{
+public:
+    using Ptr = std::shared_ptr<TxsSubmitPipeline>;
+    // handle the task, the task is forwarded to the next stage if None returned
+    using StageHandler = std::function<bcos::protocol::TransactionStatus(TxSubmitTask&)>;
+    using RejectHandler =
+        std::function<void(TxSubmitTask const&, bcos::protocol::TransactionStatus)>;
+
+    explicit TxsSubmitPipeline(RejectHandler _onRejected) : m_onRejected(std::move(_onRejected))
+    {}
+    virtual ~TxsSubmitPipeline() { stop(); }
+
+    // Note: the stages should be appended before the first task submitted
+    virtual void appendStage(std::string const& _name, size_t _workerNum, size_t _capacity,
+        StageHandler _handler);
+    // enqueue the task to the first stage, the failed task is notified with the RejectHandler
+    virtual bcos::protocol::TransactionStatus submit(TxSubmitTask::Ptr _task);
+    virtual void stop();
+
+    std::vector<TxsSubmitStageMetrics> metrics() const;
+
+protected:
+    struct Stage
+    {
+        std::string name;
+        size_t capacity;
+        StageHandler handler;
+        ThreadPool::Ptr workers;
+        std::atomic<size_t> depth = {0};
+        std::atomic<uint64_t> processedCount = {0};
+        std::atomic<uint64_t> rejectedCount = {0};
+    };
+
+    bool enqueue(size_t _stageIndex, TxSubmitTask::Ptr const& _task);
+    void handle(size_t _stageIndex, TxSubmitTask::Ptr const& _task);
+    void reject(TxSubmitTask const& _task, bcos::protocol::TransactionStatus _status);
+    void tryToReportMetrics();
+
+private:
+    RejectHandler m_onRejected;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::atomic<uint64_t> m_lastReportTime = {0};
+    uint64_t c_reportInterval = 10000;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,128 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief coalesce the unsealed txs size notifications to the sealer
+ * @file UnsealedTxsNotifier.cpp
+ * @author: yujiechen
+ * @date 2021-10-24
+ */
+#include "bcos-txpool/txpool/storage/UnsealedTxsNotifier.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+
+void UnsealedTxsNotifier::start()
+{
+    startWorking();
+}
+
+void UnsealedTxsNotifier::stop()
+{
+    finishWorker();
+    stopWorking();
+    // will not restart worker, so terminate it
+    terminate();
+}
+
+bool UnsealedTxsNotifier::significantChanged(size_t _unsealedTxsSize, int64_t _notifiedSize) const
+{
+    if (_notifiedSize < 0)
+    {
+        return true;
+    }
+    auto notifiedSize = (size_t)_notifiedSize;
+    // the sealer waits for the txs when there are no unsealed txs
+    if ((_unsealedTxsSize == 0) != (notifiedSize == 0))
+    {
+        return true;
+    }
+    auto changedSize = _unsealedTxsSize > notifiedSize ? (_unsealedTxsSize - notifiedSize) :
+                                                         (notifiedSize - _unsealedTxsSize);
+    return changedSize >= m_threshold;
+}
+
+void UnsealedTxsNotifier::update(size_t _unsealedTxsSize)
+{
+    m_unsealedTxsSize = _unsealedTxsSize;
+    if (significantChanged(_unsealedTxsSize, m_notifiedSize))
+    {
+        m_signalled.notify_all();
+    }
+}
+
+void UnsealedTxsNotifier::executeWorker()
+{
+    auto now = utcTime();
+    auto unsealedTxsSize = m_unsealedTxsSize.load();
+    auto notifiedSize = m_notifiedSize.load();
+    if ((int64_t)unsealedTxsSize != notifiedSize && now >= m_retryAfter &&
+        (now >= m_lastNotifyTime + m_intervalMs ||
+            significantChanged(unsealedTxsSize, notifiedSize)))
+    {
+        notify(unsealedTxsSize);
+    }
+    boost::unique_lock<boost::mutex> l(x_signalled);
+    m_signalled.wait_for(l, boost::chrono::milliseconds(m_intervalMs));
+}
+
+void UnsealedTxsNotifier::notify(size_t _unsealedTxsSize)
+{
+    NotifierFunc notifier;
+    {
+        Guard l(x_notifier);
+        notifier = m_notifier;
+    }
+    // Note: must set the notifier
+    if (!notifier)
+    {
+        return;
+    }
+    m_notifiedSize = _unsealedTxsSize;
+    m_lastNotifyTime = utcTime();
+    TXPOOL_LOG(TRACE) << LOG_DESC("notifyUnsealedTxsSize")
+                      << LOG_KV("unsealedTxsSize", _unsealedTxsSize);
+    auto self = std::weak_ptr<UnsealedTxsNotifier>(shared_from_this());
+    notifier(_unsealedTxsSize, [self](Error::Ptr _error) {
+        auto unsealedTxsNotifier = self.lock();
+        if (!unsealedTxsNotifier)
+        {
+            return;
+        }
+        if (_error == nullptr)
+        {
+            unsealedTxsNotifier->m_retryTime = 0;
+            return;
+        }
+        unsealedTxsNotifier->onNotifyFailed(_error);
+    });
+}
+
+void UnsealedTxsNotifier::onNotifyFailed(Error::Ptr _error)
+{
+    TXPOOL_LOG(WARNING) << LOG_DESC("notifyUnsealedTxsSize failed")
+                        << LOG_KV("errorCode", _error->errorCode())
+                        << LOG_KV("errorMsg", _error->errorMessage())
+                        << LOG_KV("retryTime", m_retryTime);
+    if (m_retryTime >= c_maxRetryTime)
+    {
+        // give up, the next change will be notified
+        m_retryTime = 0;
+        return;
+    }
+    m_retryTime++;
+    // Note: never block the callback thread, the notification is retried by the worker later
+    m_retryAfter = utcTime() + c_retryBackoffMs * m_retryTime;
+    m_notifiedSize = -1;
+}
@@ -0,0 +1,88 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief coalesce the unsealed txs size notifications to the sealer
+ * @file UnsealedTxsNotifier.h
+ * @author: yujiechen
+ * @date 2021-10-24
+ */
+#pragma once
+#include <bcos-framework/interfaces/txpool/TxPoolTypeDef.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <bcos-framework/libutilities/Worker.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+
+namespace bcos
+{
+namespace txpool
+{
+// record the latest unsealed txs size, and notify it to the sealer at most once every interval
+// milliseconds, unless the size changes by _threshold or becomes empty/non-empty
+class UnsealedTxsNotifier : public Worker, public std::enable_shared_from_this<UnsealedTxsNotifier>
+{
+public:
+    using Ptr = std::shared_ptr<UnsealedTxsNotifier>;
+    using NotifierFunc = std::function<void(size_t, std::function<void(Error::Ptr)>)>;
+    UnsealedTxsNotifier(uint64_t _intervalMs, size_t _threshold)
+      : Worker("unsealedTxsNotifier", 0),
+        m_intervalMs(std::max(_intervalMs, (uint64_t)1)),
+        m_threshold(std::max(_threshold, (size_t)1))
+    {}
+    ~UnsealedTxsNotifier() override {}
+
+    virtual void start();
+    virtual void stop();
+
+    void setNotifier(NotifierFunc _notifier)
+    {
+        Guard l(x_notifier);
+        m_notifier = _notifier;
+    }
+
+    virtual void update(size_t _unsealedTxsSize);
+
+protected:
+    void executeWorker() override;
+
+    virtual void notify(size_t _unsealedTxsSize);
+    virtual void onNotifyFailed(Error::Ptr _error);
+    bool significantChanged(size_t _unsealedTxsSize, int64_t _notifiedSize) const;
+
+private:
+    uint64_t m_intervalMs;
+    size_t m_threshold;
+
+    NotifierFunc m_notifier;
+    mutable Mutex x_notifier;
+
+    std::atomic<size_t> m_unsealedTxsSize = {0};
+    // the last notified size, -1 means the sealer should be notified again
+    std::atomic<int64_t> m_notifiedSize = {-1};
+    std::atomic<uint64_t> m_lastNotifyTime = {0};
+
+    std::atomic<size_t> m_retryTime = {0};
+    // the failed notification will not be retried before this time
+    std::atomic<uint64_t> m_retryAfter = {0};
+    size_t c_maxRetryTime = 3;
+    uint64_t c_retryBackoffMs = 100;
+
+    boost::condition_variable m_signalled;
+    // mutex to access m_signalled
+    boost::mutex x_signalled;
+};
+}  // namespace txpool
+}  // namespace bcos
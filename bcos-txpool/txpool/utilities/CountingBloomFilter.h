@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lock-free counting bloom filter for the transaction hashes
+ * @file CountingBloomFilter.h
+ * @author: yujiechen
+ * @date 2021-10-22
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <atomic>
+#include <memory>
+
+namespace bcos
+{
+namespace txpool
+{
+// Answer "definitely not present" without locking, supports removal with the counters.
+// Note: the hash is the output of the crypto hash, the positions are taken from its words
+// directly; the saturated counters are never decreased, which only increases false positives
+class CountingBloomFilter
+{
+public:
+    using Ptr = std::shared_ptr<CountingBloomFilter>;
+    explicit CountingBloomFilter(size_t _expectedSize)
+    {
+        size_t countersSize = 1024;
+        while (countersSize < _expectedSize * c_countersPerElement)
+        {
+            countersSize <<= 1;
+        }
+        m_mask = countersSize - 1;
+        m_counters = std::make_unique<std::atomic<uint8_t>[]>(countersSize);
+        for (size_t i = 0; i < countersSize; i++)
+        {
+            m_counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void insert(bcos::crypto::HashType const& _hash)
+    {
+        for (size_t i = 0; i < c_hashFunctions; i++)
+        {
+            auto& counter = m_counters[position(_hash, i)];
+            auto value = counter.load(std::memory_order_relaxed);
+            while (value < c_maxCounter && !counter.compare_exchange_weak(value, value + 1))
+            {
+            }
+        }
+    }
+
+    void remove(bcos::crypto::HashType const& _hash)
+    {
+        for (size_t i = 0; i < c_hashFunctions; i++)
+        {
+            auto& counter = m_counters[position(_hash, i)];
+            auto value = counter.load(std::memory_order_relaxed);
+            while (value > 0 && value < c_maxCounter &&
+                   !counter.compare_exchange_weak(value, value - 1))
+            {
+            }
+        }
+    }
+
+    // return false if the hash is definitely not present
+    bool mayContain(bcos::crypto::HashType const& _hash) const
+    {
+        for (size_t i = 0; i < c_hashFunctions; i++)
+        {
+            if (m_counters[position(_hash, i)].load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    size_t position(bcos::crypto::HashType const& _hash, size_t _index) const
+    {
+        uint64_t word = 0;
+        auto data = _hash.data() + _index * sizeof(uint64_t);
+        for (size_t i = 0; i < sizeof(uint64_t); i++)
+        {
+            word = (word << 8) | data[i];
+        }
+        return word & m_mask;
+    }
+
+    static constexpr size_t c_hashFunctions = 3;
+    static constexpr size_t c_countersPerElement = 8;
+    static constexpr uint8_t c_maxCounter = 255;
+    static_assert(c_hashFunctions * sizeof(uint64_t) <= bcos::crypto::HashType::size,
+        "the hash is too short for the filter");
+
+    std::unique_ptr<std::atomic<uint8_t>[]> m_counters;
+    size_t m_mask;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,242 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief fixed-size block allocator with per-thread caches for the txpool containers
+ * @file SlabAllocator.h
+ * @author: yujiechen
+ * @date 2021-10-20
+ */
+#pragma once
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace bcos
+{
+namespace txpool
+{
+struct SlabAllocatorStat
+{
+    // the blocks allocated from/freed to the system allocator
+    uint64_t systemAllocations = 0;
+    uint64_t systemDeallocations = 0;
+    // the blocks served from the cached free blocks
+    uint64_t reusedAllocations = 0;
+};
+
+// the pools of all the block sizes register here once created, so that the stat of all the
+// containers can be collected without knowing their node sizes
+class SlabPoolRegistry
+{
+public:
+    static SlabPoolRegistry& instance()
+    {
+        static auto* registry = new SlabPoolRegistry();
+        return *registry;
+    }
+    void registerPool(std::function<SlabAllocatorStat()> _stat)
+    {
+        Guard l(x_pools);
+        m_pools.emplace_back(std::move(_stat));
+    }
+    SlabAllocatorStat stat()
+    {
+        SlabAllocatorStat totalStat;
+        Guard l(x_pools);
+        for (auto const& poolStat : m_pools)
+        {
+            auto stat = poolStat();
+            totalStat.systemAllocations += stat.systemAllocations;
+            totalStat.systemDeallocations += stat.systemDeallocations;
+            totalStat.reusedAllocations += stat.reusedAllocations;
+        }
+        return totalStat;
+    }
+
+private:
+    SlabPoolRegistry() = default;
+    std::vector<std::function<SlabAllocatorStat()>> m_pools;
+    Mutex x_pools;
+};
+
+// Every block size has a pool, the freed blocks are cached by the thread that frees them, and
+// exchanged with other threads through a shared depot in magazines of c_magazineSize blocks, so
+// that the blocks freed by the committing thread can be reused by the importing threads.
+template <size_t BlockSize>
+class SlabPool
+{
+public:
+    static SlabPool& instance()
+    {
+        // Note: never destroyed, in case of the thread caches released after the pool
+        static auto* pool = new SlabPool();
+        return *pool;
+    }
+
+    void* allocate()
+    {
+        auto& blocks = localCache().blocks;
+        if (blocks.empty())
+        {
+            refill(blocks);
+        }
+        if (!blocks.empty())
+        {
+            auto block = blocks.back();
+            blocks.pop_back();
+            m_reusedAllocations++;
+            return block;
+        }
+        m_systemAllocations++;
+        return ::operator new(BlockSize);
+    }
+
+    void deallocate(void* _block)
+    {
+        auto& blocks = localCache().blocks;
+        blocks.emplace_back(_block);
+        if (blocks.size() >= 2 * c_magazineSize)
+        {
+            flush(blocks, c_magazineSize);
+        }
+    }
+
+    SlabAllocatorStat stat() const
+    {
+        SlabAllocatorStat stat;
+        stat.systemAllocations = m_systemAllocations;
+        stat.systemDeallocations = m_systemDeallocations;
+        stat.reusedAllocations = m_reusedAllocations;
+        return stat;
+    }
+
+private:
+    SlabPool()
+    {
+        SlabPoolRegistry::instance().registerPool([this]() { return stat(); });
+    }
+    using Magazine = std::vector<void*>;
+
+    struct LocalCache
+    {
+        Magazine blocks;
+        ~LocalCache() { SlabPool::instance().flush(blocks, blocks.size()); }
+    };
+    static LocalCache& localCache()
+    {
+        static thread_local LocalCache cache;
+        return cache;
+    }
+
+    void refill(Magazine& _blocks)
+    {
+        Guard l(x_depot);
+        if (m_depot.empty())
+        {
+            return;
+        }
+        _blocks.swap(m_depot.back());
+        m_depot.pop_back();
+    }
+
+    // move _size blocks from the thread cache to the depot, free them if the depot is full
+    void flush(Magazine& _blocks, size_t _size)
+    {
+        while (_size > 0)
+        {
+            auto magazineSize = std::min(_size, c_magazineSize);
+            Magazine magazine(_blocks.end() - magazineSize, _blocks.end());
+            _blocks.resize(_blocks.size() - magazineSize);
+            _size -= magazineSize;
+            {
+                Guard l(x_depot);
+                if (m_depot.size() < c_maxDepotSize)
+                {
+                    m_depot.emplace_back(std::move(magazine));
+                    continue;
+                }
+            }
+            for (auto block : magazine)
+            {
+                ::operator delete(block);
+                m_systemDeallocations++;
+            }
+        }
+    }
+
+    const size_t c_magazineSize = 64;
+    // cache at most c_maxDepotSize * c_magazineSize blocks in the depot
+    const size_t c_maxDepotSize = 1024;
+
+    std::vector<Magazine> m_depot;
+    Mutex x_depot;
+
+    std::atomic<uint64_t> m_systemAllocations = {0};
+    std::atomic<uint64_t> m_systemDeallocations = {0};
+    std::atomic<uint64_t> m_reusedAllocations = {0};
+};
+
+// STL-compatible allocator, the single-object allocations (the nodes of the node-based
+// containers) are served by the SlabPool, others by the default allocator
+template <class T>
+class SlabAllocator
+{
+public:
+    using value_type = T;
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+        "SlabAllocator not support over-aligned types");
+
+    SlabAllocator() noexcept = default;
+    template <class U>
+    SlabAllocator(SlabAllocator<U> const&) noexcept
+    {}
+
+    T* allocate(size_t _size)
+    {
+        if (_size == 1)
+        {
+            return static_cast<T*>(SlabPool<sizeof(T)>::instance().allocate());
+        }
+        return std::allocator<T>().allocate(_size);
+    }
+
+    void deallocate(T* _block, size_t _size) noexcept
+    {
+        if (_size == 1)
+        {
+            SlabPool<sizeof(T)>::instance().deallocate(_block);
+            return;
+        }
+        std::allocator<T>().deallocate(_block, _size);
+    }
+
+    static SlabAllocatorStat stat() { return SlabPool<sizeof(T)>::instance().stat(); }
+
+    template <class U>
+    bool operator==(SlabAllocator<U> const&) const noexcept
+    {
+        return true;
+    }
+    template <class U>
+    bool operator!=(SlabAllocator<U> const&) const noexcept
+    {
+        return false;
+    }
+};
+}  // namespace txpool
+}  // namespace bcos
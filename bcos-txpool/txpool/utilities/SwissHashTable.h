@@ -0,0 +1,370 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief open-addressing hash table keyed by the transaction hash
+ * @file SwissHashTable.h
+ * @author: yujiechen
+ * @date 2021-10-24
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bcos
+{
+namespace txpool
+{
+// Swiss-table-style hash table: every slot has a control byte holding 7 bits of the hash, the
+// control bytes of a group of 16 slots are compared at once(SSE2, or the scalar fallback), so
+// that the slots are only touched for the candidates.
+// The keys are crypto hashes, the hash is taken from the leading bytes of the key directly.
+// Note: not thread-safe by itself, the lookups can run concurrently, the modifications must be
+// exclusive(the txs table is guarded by the shard lock); the slots move only on rehash
+template <class Value>
+class SwissHashTable
+{
+public:
+    using key_type = bcos::crypto::HashType;
+    using mapped_type = Value;
+    using value_type = std::pair<const key_type, Value>;
+
+    template <class TableType, class Reference>
+    class IteratorImpl
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SwissHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = Reference;
+        using pointer = std::remove_reference_t<Reference>*;
+
+        IteratorImpl() = default;
+        IteratorImpl(TableType* _table, size_t _index) : m_table(_table), m_index(_index)
+        {
+            skipEmptySlots();
+        }
+        // iterator => const_iterator
+        template <class OtherTable, class OtherReference>
+        IteratorImpl(IteratorImpl<OtherTable, OtherReference> const& _other)
+          : m_table(_other.m_table), m_index(_other.m_index)
+        {}
+
+        reference operator*() const { return m_table->m_slots[m_index]; }
+        pointer operator->() const { return &m_table->m_slots[m_index]; }
+        IteratorImpl& operator++()
+        {
+            m_index++;
+            skipEmptySlots();
+            return *this;
+        }
+        IteratorImpl operator++(int)
+        {
+            auto origin = *this;
+            ++(*this);
+            return origin;
+        }
+        bool operator==(IteratorImpl const& _other) const { return m_index == _other.m_index; }
+        bool operator!=(IteratorImpl const& _other) const { return m_index != _other.m_index; }
+
+    private:
+        friend class SwissHashTable;
+        template <class, class>
+        friend class IteratorImpl;
+        void skipEmptySlots()
+        {
+            while (m_index < m_table->m_capacity && !isFull(m_table->m_ctrl[m_index]))
+            {
+                m_index++;
+            }
+        }
+        TableType* m_table = nullptr;
+        size_t m_index = 0;
+    };
+    using iterator = IteratorImpl<SwissHashTable, value_type&>;
+    using const_iterator = IteratorImpl<SwissHashTable const, value_type const&>;
+
+    SwissHashTable() = default;
+    SwissHashTable(SwissHashTable const&) = delete;
+    SwissHashTable& operator=(SwissHashTable const&) = delete;
+    ~SwissHashTable() { destroy(); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_capacity); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_capacity); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    // increased once the slots moved
+    uint64_t rehashCount() const { return m_rehashCount; }
+
+    iterator find(key_type const& _key) { return iterator(this, findIndex(_key)); }
+    const_iterator find(key_type const& _key) const
+    {
+        return const_iterator(this, findIndex(_key));
+    }
+    size_t count(key_type const& _key) const { return findIndex(_key) != m_capacity ? 1 : 0; }
+
+    std::pair<iterator, bool> emplace(key_type const& _key, Value _value)
+    {
+        auto index = findIndex(_key);
+        if (index != m_capacity)
+        {
+            return std::make_pair(iterator(this, index), false);
+        }
+        index = prepareInsert(_key);
+        new (&m_slots[index]) value_type(_key, std::move(_value));
+        return std::make_pair(iterator(this, index), true);
+    }
+
+    Value& operator[](key_type const& _key) { return emplace(_key, Value()).first->second; }
+
+    size_t erase(key_type const& _key)
+    {
+        auto index = findIndex(_key);
+        if (index == m_capacity)
+        {
+            return 0;
+        }
+        eraseIndex(index);
+        return 1;
+    }
+    void erase(const_iterator _it) { eraseIndex(_it.m_index); }
+
+    void clear()
+    {
+        destroy();
+        m_ctrl.reset();
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growthLeft = 0;
+        m_rehashCount++;
+    }
+
+private:
+    // the control bytes: empty and deleted are negative, the full slot holds the 7-bit hash
+    static constexpr int8_t c_empty = -128;
+    static constexpr int8_t c_deleted = -2;
+    static constexpr size_t c_groupSize = 16;
+    static bool isFull(int8_t _ctrl) { return _ctrl >= 0; }
+
+    // Note: the hash is uniformly distributed, use the leading 8 bytes as the hash value
+    static uint64_t hashOf(key_type const& _key)
+    {
+        static_assert(key_type::size >= sizeof(uint64_t), "the key is too short");
+        uint64_t hash;
+        std::memcpy(&hash, _key.data(), sizeof(hash));
+        return hash;
+    }
+    static int8_t h2(uint64_t _hash) { return (int8_t)(_hash & 0x7f); }
+    size_t groupMask() const { return m_capacity / c_groupSize - 1; }
+
+    // the bitmask of the slots matched in the group
+    struct Group
+    {
+        explicit Group(int8_t const* _ctrl)
+        {
+#if defined(__SSE2__)
+            m_ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_ctrl));
+#else
+            m_ctrl = _ctrl;
+#endif
+        }
+#if defined(__SSE2__)
+        uint32_t match(int8_t _h2) const
+        {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(_h2), m_ctrl));
+        }
+        uint32_t matchEmpty() const { return match(c_empty); }
+        // the sign bits of the empty and deleted slots are set
+        uint32_t matchEmptyOrDeleted() const { return _mm_movemask_epi8(m_ctrl); }
+        __m128i m_ctrl;
+#else
+        uint32_t match(int8_t _h2) const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < c_groupSize; i++)
+            {
+                mask |= (uint32_t)(m_ctrl[i] == _h2) << i;
+            }
+            return mask;
+        }
+        uint32_t matchEmpty() const { return match(c_empty); }
+        uint32_t matchEmptyOrDeleted() const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < c_groupSize; i++)
+            {
+                mask |= (uint32_t)(m_ctrl[i] < 0) << i;
+            }
+            return mask;
+        }
+        int8_t const* m_ctrl;
+#endif
+    };
+    static size_t lowestBit(uint32_t _mask) { return __builtin_ctz(_mask); }
+
+    // return m_capacity if not found
+    size_t findIndex(key_type const& _key) const
+    {
+        if (m_capacity == 0)
+        {
+            return m_capacity;
+        }
+        auto hash = hashOf(_key);
+        auto tag = h2(hash);
+        auto group = (hash >> 7) & groupMask();
+        // triangular probing over the groups visits every group once
+        for (size_t step = 1;; step++)
+        {
+            auto ctrl = m_ctrl.get() + group * c_groupSize;
+            Group g(ctrl);
+            for (auto mask = g.match(tag); mask != 0; mask &= mask - 1)
+            {
+                auto index = group * c_groupSize + lowestBit(mask);
+                if (m_slots[index].first == _key)
+                {
+                    return index;
+                }
+            }
+            if (g.matchEmpty() != 0)
+            {
+                return m_capacity;
+            }
+            group = (group + step) & groupMask();
+        }
+    }
+
+    // find the slot for the new key, and mark it as full
+    size_t prepareInsert(key_type const& _key)
+    {
+        if (m_growthLeft == 0)
+        {
+            // too many deleted slots, reclaim them without growth
+            auto newCapacity = (m_capacity == 0) ? c_groupSize : m_capacity;
+            if (m_size >= maxLoad(m_capacity) / 2)
+            {
+                newCapacity = (m_capacity == 0) ? c_groupSize : m_capacity * 2;
+            }
+            rehash(newCapacity);
+        }
+        auto hash = hashOf(_key);
+        auto index = findEmptyOrDeleted(hash);
+        if (m_ctrl[index] == c_empty)
+        {
+            m_growthLeft--;
+        }
+        m_ctrl[index] = h2(hash);
+        m_size++;
+        return index;
+    }
+
+    size_t findEmptyOrDeleted(uint64_t _hash) const
+    {
+        auto group = (_hash >> 7) & groupMask();
+        for (size_t step = 1;; step++)
+        {
+            auto mask = Group(m_ctrl.get() + group * c_groupSize).matchEmptyOrDeleted();
+            if (mask != 0)
+            {
+                return group * c_groupSize + lowestBit(mask);
+            }
+            group = (group + step) & groupMask();
+        }
+    }
+
+    void eraseIndex(size_t _index)
+    {
+        m_slots[_index].~value_type();
+        m_size--;
+        // the probing never passed through the group with an empty slot, the slot can be
+        // reused as empty directly
+        auto groupStart = _index & ~(c_groupSize - 1);
+        if (Group(m_ctrl.get() + groupStart).matchEmpty() != 0)
+        {
+            m_ctrl[_index] = c_empty;
+            m_growthLeft++;
+            return;
+        }
+        m_ctrl[_index] = c_deleted;
+    }
+
+    // at most 7/8 of the slots are used, so that the probing always ends at an empty slot
+    static size_t maxLoad(size_t _capacity) { return _capacity - _capacity / 8; }
+
+    void rehash(size_t _newCapacity)
+    {
+        auto oldCtrl = std::move(m_ctrl);
+        auto oldSlots = m_slots;
+        auto oldCapacity = m_capacity;
+
+        m_ctrl = std::make_unique<int8_t[]>(_newCapacity);
+        std::memset(m_ctrl.get(), c_empty, _newCapacity);
+        m_slots = std::allocator<value_type>().allocate(_newCapacity);
+        m_capacity = _newCapacity;
+        m_growthLeft = maxLoad(_newCapacity) - m_size;
+        m_rehashCount++;
+        for (size_t i = 0; i < oldCapacity; i++)
+        {
+            if (!isFull(oldCtrl[i]))
+            {
+                continue;
+            }
+            auto hash = hashOf(oldSlots[i].first);
+            auto index = findEmptyOrDeleted(hash);
+            m_ctrl[index] = h2(hash);
+            new (&m_slots[index]) value_type(std::move(oldSlots[i]));
+            oldSlots[i].~value_type();
+        }
+        if (oldSlots)
+        {
+            std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    void destroy()
+    {
+        if (!m_slots)
+        {
+            return;
+        }
+        for (size_t i = 0; i < m_capacity; i++)
+        {
+            if (isFull(m_ctrl[i]))
+            {
+                m_slots[i].~value_type();
+            }
+        }
+        std::allocator<value_type>().deallocate(m_slots, m_capacity);
+    }
+
+    std::unique_ptr<int8_t[]> m_ctrl;
+    value_type* m_slots = nullptr;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+    // the empty slots can be used before rehash
+    size_t m_growthLeft = 0;
+    uint64_t m_rehashCount = 0;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -25,6 +25,22 @@ using namespace bcos::protocol;
 using namespace bcos::txpool;
 
 TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
+{
+    auto status = checkTransaction(_tx);
+    if (status != TransactionStatus::None)
+    {
+        return status;
+    }
+    status = verifySignature(_tx);
+    if (status != TransactionStatus::None)
+    {
+        return status;
+    }
+    // Note: this must be the last check for updating the txPoolNonceChecker
+    return checkPoolNonce(_tx);
+}
+
+TransactionStatus TxValidator::checkTransaction(bcos::protocol::Transaction::ConstPtr _tx)
 {
     if (_tx->invalid())
     {
@@ -39,12 +55,11 @@ TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
     {
         return TransactionStatus::InvalidChainId;
     }
-    auto status = submittedToChain(_tx);
-    if (status != TransactionStatus::None)
-    {
-        return status;
-    }
-    // check signature
+    return submittedToChain(_tx);
+}
+
+TransactionStatus TxValidator::verifySignature(bcos::protocol::Transaction::ConstPtr _tx)
+{
     try
     {
         _tx->verify();
@@ -53,9 +68,13 @@ TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
     {
         return TransactionStatus::InvalidSignature;
     }
+    return TransactionStatus::None;
+}
+
+TransactionStatus TxValidator::checkPoolNonce(bcos::protocol::Transaction::ConstPtr _tx)
+{
     // compare with nonces cached in memory
-    // Note: this must be the last check for updating the txPoolNonceChecker
-    status = m_txPoolNonceChecker->checkNonce(_tx, true);
+    auto status = m_txPoolNonceChecker->checkNonce(_tx, true);
     if (status != TransactionStatus::None)
     {
         return status;
@@ -42,6 +42,12 @@ public:
     ~TxValidator() override {}
 
     bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus checkTransaction(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus verifySignature(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus checkPoolNonce(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
     bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) override;
 
@@ -0,0 +1,203 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief benchmark for the serial and parallel batch operations of the txpool storage
+ * @file BatchOperationsTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-25
+ */
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/interfaces/crypto/CryptoSuite.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <bcos-framework/testutils/crypto/SignatureImpl.h>
+#include <bcos-framework/testutils/protocol/FakeTransaction.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(batchOperationsTest, TestPromptFixture)
+
+struct BatchOperationsCost
+{
+    // in microseconds
+    int64_t fetchTxs = 0;
+    int64_t verifyProposal = 0;
+    int64_t markTxs = 0;
+    int64_t removeTxs = 0;
+};
+
+// the outputs of the batch operations, the serial and the parallel runs should be identical
+struct BatchOperationsResult
+{
+    HashList fetchedTxs;
+    HashList missedTxs;
+    bool verified = false;
+    size_t unsealedSizeAfterMarked = 0;
+    HashList proposalTxs;
+    size_t unsealedSizeAfterUnmarked = 0;
+    HashList markedTxsAfterUnmarked;
+    size_t sizeAfterRemoved = 0;
+    size_t unsealedSizeAfterRemoved = 0;
+
+    bool operator==(BatchOperationsResult const& _result) const
+    {
+        return fetchedTxs == _result.fetchedTxs && missedTxs == _result.missedTxs &&
+               verified == _result.verified &&
+               unsealedSizeAfterMarked == _result.unsealedSizeAfterMarked &&
+               proposalTxs == _result.proposalTxs &&
+               unsealedSizeAfterUnmarked == _result.unsealedSizeAfterUnmarked &&
+               markedTxsAfterUnmarked == _result.markedTxsAfterUnmarked &&
+               sizeAfterRemoved == _result.sizeAfterRemoved &&
+               unsealedSizeAfterRemoved == _result.unsealedSizeAfterRemoved;
+    }
+};
+
+int64_t elapsedMicroseconds(std::chrono::steady_clock::time_point const& _startT)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startT)
+        .count();
+}
+
+BatchOperationsCost runBatchOperations(TxPoolConfig::Ptr _config, Transactions const& _txs,
+    HashListPtr _txsHash, size_t _parallelThreshold, BatchOperationsResult& _result)
+{
+    _config->setBulkParallelThreshold(_parallelThreshold);
+    // the txs are reused by the runs
+    for (auto const& tx : _txs)
+    {
+        tx->setSealed(false);
+        tx->setBatchId(-1);
+        tx->setBatchHash(HashType());
+    }
+    auto storage = std::make_shared<MemoryStorage>(_config);
+    storage->batchInsert(_txs);
+    BOOST_CHECK_EQUAL(storage->size(), _txs.size());
+    BatchOperationsCost cost;
+
+    auto startT = std::chrono::steady_clock::now();
+    HashList missedTxs;
+    auto fetchedTxs = storage->fetchTxs(missedTxs, *_txsHash);
+    cost.fetchTxs = elapsedMicroseconds(startT);
+    for (auto const& tx : *fetchedTxs)
+    {
+        _result.fetchedTxs.emplace_back(tx->hash());
+    }
+    _result.missedTxs = missedTxs;
+    BOOST_CHECK(missedTxs.empty());
+    BOOST_CHECK_EQUAL(fetchedTxs->size(), _txs.size());
+    // the fetched txs keep the order of the given hashes
+    bool ordered = true;
+    for (size_t i = 0; i < fetchedTxs->size(); i++)
+    {
+        ordered = ordered && ((*fetchedTxs)[i]->hash() == (*_txsHash)[i]);
+    }
+    BOOST_CHECK(ordered);
+
+    startT = std::chrono::steady_clock::now();
+    _result.verified = storage->batchVerifyProposal(_txsHash);
+    cost.verifyProposal = elapsedMicroseconds(startT);
+    BOOST_CHECK(_result.verified);
+
+    startT = std::chrono::steady_clock::now();
+    storage->batchMarkTxs(*_txsHash, 1, HashType(), true);
+    cost.markTxs = elapsedMicroseconds(startT);
+    _result.unsealedSizeAfterMarked = storage->unSealedTxsSize();
+    BOOST_CHECK_EQUAL(_result.unsealedSizeAfterMarked, 0);
+    _result.proposalTxs = *(storage->fetchProposalTxs(1, HashType()));
+    std::sort(_result.proposalTxs.begin(), _result.proposalTxs.end());
+
+    // unmark the first half of the txs
+    HashList unmarkedTxs(_txsHash->begin(), _txsHash->begin() + _txsHash->size() / 2);
+    storage->batchMarkTxs(unmarkedTxs, 1, HashType(), false);
+    _result.unsealedSizeAfterUnmarked = storage->unSealedTxsSize();
+    BOOST_CHECK_EQUAL(_result.unsealedSizeAfterUnmarked, unmarkedTxs.size());
+    _result.markedTxsAfterUnmarked = *(storage->fetchProposalTxs(1, HashType()));
+    std::sort(_result.markedTxsAfterUnmarked.begin(), _result.markedTxsAfterUnmarked.end());
+    BOOST_CHECK_EQUAL(
+        _result.markedTxsAfterUnmarked.size(), _txsHash->size() - unmarkedTxs.size());
+
+    TransactionSubmitResults txsResult;
+    for (auto const& txHash : *_txsHash)
+    {
+        auto txResult = _config->txResultFactory()->createTxSubmitResult();
+        txResult->setTxHash(txHash);
+        txsResult.emplace_back(txResult);
+    }
+    startT = std::chrono::steady_clock::now();
+    storage->batchRemove(1, txsResult);
+    cost.removeTxs = elapsedMicroseconds(startT);
+    _result.sizeAfterRemoved = storage->size();
+    _result.unsealedSizeAfterRemoved = storage->unSealedTxsSize();
+    BOOST_CHECK_EQUAL(_result.sizeAfterRemoved, 0);
+    BOOST_CHECK_EQUAL(_result.unsealedSizeAfterRemoved, 0);
+    storage->stop();
+    return cost;
+}
+
+BOOST_AUTO_TEST_CASE(testParallelBatchOperations)
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "test-group";
+    std::string chainId = "test-chain";
+    int64_t blockLimit = 15;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    auto config = faker->txpool()->txpoolConfig();
+    auto ledger = faker->ledger();
+
+    // a 10k-tx block
+    size_t txsSize = 10000;
+    Transactions txs;
+    auto txsHash = std::make_shared<HashList>();
+    for (size_t i = 0; i < txsSize; i++)
+    {
+        auto tx = fakeTransaction(
+            cryptoSuite, utcTime() + 1000 + i, ledger->blockNumber() + blockLimit, chainId, groupId);
+        txs.emplace_back(tx);
+        txsHash->emplace_back(tx->hash());
+    }
+    config->setPoolLimit(2 * txsSize);
+    BatchOperationsResult serialResult;
+    BatchOperationsResult parallelResult;
+    auto serialCost = runBatchOperations(config, txs, txsHash, txsSize + 1, serialResult);
+    auto parallelCost = runBatchOperations(config, txs, txsHash, 1000, parallelResult);
+    // the parallel operations give the same results as the serial ones
+    BOOST_CHECK(serialResult == parallelResult);
+    std::cout << "#### batch operations on " << txsSize << " txs(serial/parallel, us): "
+              << "fetchTxs: " << serialCost.fetchTxs << "/" << parallelCost.fetchTxs
+              << ", batchVerifyProposal: " << serialCost.verifyProposal << "/"
+              << parallelCost.verifyProposal << ", batchMarkTxs: " << serialCost.markTxs << "/"
+              << parallelCost.markTxs << ", batchRemove: " << serialCost.removeTxs << "/"
+              << parallelCost.removeTxs << std::endl;
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,149 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the KnownTxsTracker
+ * @file KnownTxsTrackerTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-23
+ */
+#include "bcos-txpool/sync/KnownTxsTracker.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::sync;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(knownTxsTrackerTest, TestPromptFixture)
+
+HashList fakeTxsHash(CryptoSuite::Ptr _cryptoSuite, std::string const& _prefix, size_t _txsNum)
+{
+    HashList txsHash;
+    for (size_t i = 0; i < _txsNum; i++)
+    {
+        txsHash.emplace_back(_cryptoSuite->hashImpl()->hash(_prefix + std::to_string(i)));
+    }
+    return txsHash;
+}
+
+size_t knownTxsSize(KnownTxsTracker::Ptr _tracker, NodeIDPtr _peer, HashList const& _txsHash)
+{
+    size_t knownSize = 0;
+    for (auto const& txHash : _txsHash)
+    {
+        if (_tracker->isKnown(_peer, txHash))
+        {
+            knownSize++;
+        }
+    }
+    return knownSize;
+}
+
+BOOST_AUTO_TEST_CASE(testMarkKnown)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto peer = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    auto otherPeer = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    auto tracker = std::make_shared<KnownTxsTracker>(1000);
+
+    auto txsHash = fakeTxsHash(cryptoSuite, "tx", 100);
+    // the unknown peer knows nothing
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, txsHash), 0);
+
+    // mark the txs one by one
+    for (size_t i = 0; i < txsHash.size() / 2; i++)
+    {
+        tracker->markKnown(peer, txsHash[i]);
+    }
+    for (size_t i = 0; i < txsHash.size() / 2; i++)
+    {
+        BOOST_CHECK(tracker->isKnown(peer, txsHash[i]));
+    }
+    // mark the txs in batch
+    HashList restTxsHash(txsHash.begin() + txsHash.size() / 2, txsHash.end());
+    tracker->markKnown(peer, restTxsHash);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, txsHash), txsHash.size());
+
+    // the known txs are tracked per peer
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, otherPeer, txsHash), 0);
+    // the false positive rate of the txs never marked is low
+    auto unknownTxsHash = fakeTxsHash(cryptoSuite, "unknown", 1000);
+    BOOST_CHECK(knownTxsSize(tracker, peer, unknownTxsHash) <= unknownTxsHash.size() / 20);
+}
+
+BOOST_AUTO_TEST_CASE(testRollover)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto peer = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    size_t capacity = 100;
+    auto tracker = std::make_shared<KnownTxsTracker>(capacity);
+
+    auto oldestTxsHash = fakeTxsHash(cryptoSuite, "oldest", capacity);
+    auto olderTxsHash = fakeTxsHash(cryptoSuite, "older", capacity);
+    auto latestTxsHash = fakeTxsHash(cryptoSuite, "latest", capacity);
+    tracker->markKnown(peer, oldestTxsHash);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, oldestTxsHash), capacity);
+    // the older generation is still kept after the first roll over
+    tracker->markKnown(peer, olderTxsHash);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, oldestTxsHash), capacity);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, olderTxsHash), capacity);
+    // the oldest generation is dropped after the second roll over
+    tracker->markKnown(peer, latestTxsHash);
+    BOOST_CHECK(knownTxsSize(tracker, peer, oldestTxsHash) <= capacity / 10);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, olderTxsHash), capacity);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, latestTxsHash), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveStalePeers)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto tracker = std::make_shared<KnownTxsTracker>(1000);
+    auto txsHash = fakeTxsHash(cryptoSuite, "tx", 10);
+    std::vector<NodeIDPtr> peers;
+    for (size_t i = 0; i < 4; i++)
+    {
+        peers.emplace_back(cryptoSuite->signatureImpl()->generateKeyPair()->publicKey());
+        tracker->markKnown(peers.back(), txsHash);
+    }
+    // only the first two peers are still connected
+    NodeIDSet connectedPeers;
+    connectedPeers.insert(peers[0]);
+    connectedPeers.insert(peers[1]);
+    tracker->removeStalePeers(connectedPeers);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peers[0], txsHash), txsHash.size());
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peers[1], txsHash), txsHash.size());
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peers[2], txsHash), 0);
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peers[3], txsHash), 0);
+
+    // the removed peer is tracked from scratch once reconnected
+    tracker->markKnown(peers[2], txsHash[0]);
+    BOOST_CHECK(tracker->isKnown(peers[2], txsHash[0]));
+    BOOST_CHECK_EQUAL(knownTxsSize(tracker, peers[2], txsHash), 1);
+
+    // all the peers are removed when none connected
+    tracker->removeStalePeers(NodeIDSet());
+    for (auto const& peer : peers)
+    {
+        BOOST_CHECK_EQUAL(knownTxsSize(tracker, peer, txsHash), 0);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,245 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the MemoryStorage
+ * @file MemoryStorageTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-28
+ */
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/interfaces/crypto/CryptoSuite.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <bcos-framework/testutils/crypto/SignatureImpl.h>
+#include <bcos-framework/testutils/protocol/FakeTransaction.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(memoryStorageTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testExpireSealedTx)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto expiredNumber = faker->ledger()->blockNumber() + 1;
+
+    // the sealed tx and the unsealed tx expire at the same block
+    auto sealedTx = fakeTx(cryptoSuite, faker, utcTime() + 1000, expiredNumber);
+    storage->insert(sealedTx);
+    auto fetchedTxs = fetchTxsHash(storage, faker->blockFactory(), 10);
+    BOOST_CHECK_EQUAL(fetchedTxs.size(), 1);
+    BOOST_CHECK(sealedTx->sealed());
+    auto unsealedTx = fakeTx(cryptoSuite, faker, utcTime() + 1001, expiredNumber);
+    storage->insert(unsealedTx);
+    BOOST_CHECK_EQUAL(storage->size(), 2);
+
+    // only the unsealed tx is removed, the sealed tx is kept until its proposal released
+    storage->batchRemove(expiredNumber, TransactionSubmitResults());
+    BOOST_CHECK_EQUAL(storage->size(), 1);
+    BOOST_CHECK(storage->exist(sealedTx->hash()));
+    BOOST_CHECK(!storage->exist(unsealedTx->hash()));
+
+    // the scan over the meta table sees exactly the txs of the pool
+    fetchedTxs = fetchTxsHash(storage, faker->blockFactory(), 10, false);
+    BOOST_REQUIRE_EQUAL(fetchedTxs.size(), 1);
+    BOOST_CHECK(fetchedTxs[0] == sealedTx->hash());
+
+    // the expired tx is removed once unsealed
+    storage->batchMarkAllTxs(false);
+    BOOST_CHECK(waitUntil([&storage]() { return storage->size() == 0; }));
+    fetchedTxs = fetchTxsHash(storage, faker->blockFactory(), 10, false);
+    BOOST_CHECK(fetchedTxs.empty());
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testReleaseNonceOfRejectedTx)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    config->setEvictionPolicyType(TxsEvictionPolicyType::OldestFirst);
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000, blockLimit);
+    BOOST_CHECK(storage->submitTransaction(tx) == TransactionStatus::None);
+    config->setPoolMemoryLimit(2 * storage->memorySize());
+
+    // the tx larger than the memory limit passes the pre-check for a victim can be selected, but
+    // is rejected after all the victims evicted
+    auto keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+    bytes input(4 * config->poolMemoryLimit(), 1);
+    auto largeTx = fakeTransaction(cryptoSuite, keyPair, bytes(20, 1), input, utcTime() + 1001,
+        blockLimit, faker->chainId(), faker->groupId());
+    BOOST_CHECK(storage->submitTransaction(largeTx) == TransactionStatus::TxPoolIsFull);
+    BOOST_CHECK_EQUAL(storage->size(), 0);
+    // the nonce of the rejected tx is released
+    BOOST_CHECK(config->txPoolNonceChecker()->checkNonce(largeTx) == TransactionStatus::None);
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testEvictionSkipsSealedTxs)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    config->setEvictionPolicyType(TxsEvictionPolicyType::OldestFirst);
+    config->setPoolLimit(3);
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    for (int64_t importTime = 1; importTime <= 3; importTime++)
+    {
+        auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + importTime, blockLimit);
+        tx->setImportTime(importTime);
+        storage->insert(tx);
+        txs.emplace_back(tx);
+    }
+    // the oldest tx is referenced by the proposal, the second one is fetched by the sealer
+    auto batchHash = cryptoSuite->hashImpl()->hash(std::string("proposal"));
+    storage->batchMarkTxs(HashList{txs[0]->hash()}, faker->ledger()->blockNumber() + 1, batchHash,
+        true);
+    BOOST_CHECK_EQUAL(fetchTxsHash(storage, faker->blockFactory(), 1).size(), 1);
+    BOOST_CHECK(txs[1]->sealed());
+
+    // only the unsealed tx is evicted
+    auto incomingTx = fakeTx(cryptoSuite, faker, utcTime() + 1004, blockLimit);
+    BOOST_CHECK(storage->submitTransaction(incomingTx) == TransactionStatus::None);
+    BOOST_CHECK(storage->exist(txs[0]->hash()));
+    BOOST_CHECK(storage->exist(txs[1]->hash()));
+    BOOST_CHECK(!storage->exist(txs[2]->hash()));
+    BOOST_CHECK(config->txPoolNonceChecker()->checkNonce(txs[2]) == TransactionStatus::None);
+
+    // no room can be made once all the txs sealed
+    BOOST_CHECK_EQUAL(fetchTxsHash(storage, faker->blockFactory(), 1).size(), 1);
+    incomingTx = fakeTx(cryptoSuite, faker, utcTime() + 1005, blockLimit);
+    BOOST_CHECK(storage->submitTransaction(incomingTx) == TransactionStatus::TxPoolIsFull);
+    BOOST_CHECK_EQUAL(storage->size(), 3);
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testSystemTxDisplacesNormalTx)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    config->setPoolLimit(2);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    // the full txpool rejects all the txs by default
+    auto storage = std::make_shared<MemoryStorage>(config);
+    Transactions txs;
+    for (int64_t importTime = 1; importTime <= 2; importTime++)
+    {
+        auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + importTime, blockLimit);
+        tx->setImportTime(importTime);
+        storage->insert(tx);
+        txs.emplace_back(tx);
+    }
+    auto systemTx = fakeTx(cryptoSuite, faker, utcTime() + 1002, blockLimit);
+    systemTx->setSystemTx(true);
+    BOOST_CHECK(storage->submitTransaction(systemTx) == TransactionStatus::TxPoolIsFull);
+    storage->stop();
+
+    config->setEvictionPolicyType(TxsEvictionPolicyType::LowestPriorityFirst);
+    storage = std::make_shared<MemoryStorage>(config);
+    storage->batchInsert(txs);
+    // the normal tx can not make room
+    auto normalTx = fakeTx(cryptoSuite, faker, utcTime() + 1003, blockLimit);
+    BOOST_CHECK(storage->submitTransaction(normalTx) == TransactionStatus::TxPoolIsFull);
+    // the system tx displaces the newest normal tx
+    BOOST_CHECK(storage->submitTransaction(systemTx) == TransactionStatus::None);
+    BOOST_CHECK_EQUAL(storage->size(), 2);
+    BOOST_CHECK(storage->exist(systemTx->hash()));
+    BOOST_CHECK(storage->exist(txs[0]->hash()));
+    BOOST_CHECK(!storage->exist(txs[1]->hash()));
+    // the system txs are never evicted
+    auto anotherSystemTx = fakeTx(cryptoSuite, faker, utcTime() + 1004, blockLimit);
+    anotherSystemTx->setSystemTx(true);
+    BOOST_CHECK(storage->submitTransaction(anotherSystemTx) == TransactionStatus::None);
+    BOOST_CHECK(!storage->exist(txs[0]->hash()));
+    auto lastSystemTx = fakeTx(cryptoSuite, faker, utcTime() + 1005, blockLimit);
+    lastSystemTx->setSystemTx(true);
+    BOOST_CHECK(storage->submitTransaction(lastSystemTx) == TransactionStatus::TxPoolIsFull);
+    BOOST_CHECK(storage->exist(systemTx->hash()));
+    BOOST_CHECK(storage->exist(anotherSystemTx->hash()));
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testRebucketSealedExpiredTx)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto expiredNumber = faker->ledger()->blockNumber() + 1;
+    auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000, expiredNumber);
+    std::atomic<uint32_t> notifiedStatus = {(uint32_t)TransactionStatus::None};
+    std::atomic_bool notified = {false};
+    tx->setSubmitCallback([&](Error::Ptr, TransactionSubmitResult::Ptr _result) {
+        notifiedStatus = _result->status();
+        notified = true;
+    });
+    storage->insert(tx);
+    // the tx is sealed by the proposal of the next block
+    auto batchHash = cryptoSuite->hashImpl()->hash(std::string("proposal"));
+    storage->batchMarkTxs(HashList{tx->hash()}, expiredNumber + 1, batchHash, true);
+
+    // the expired tx is kept for the proposal, and checked again with the next block
+    storage->batchRemove(expiredNumber, TransactionSubmitResults());
+    BOOST_CHECK(storage->exist(tx->hash()));
+    BOOST_CHECK(!notified);
+
+    // the proposal is released with the next block, the tx is removed as expired
+    storage->batchRemove(expiredNumber + 1, TransactionSubmitResults());
+    BOOST_CHECK_EQUAL(storage->size(), 0);
+    BOOST_CHECK(waitUntil([&notified]() { return notified.load(); }));
+    BOOST_CHECK_EQUAL(notifiedStatus, (uint32_t)TransactionStatus::BlockLimitCheckFail);
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testExpireBeforeFirstCommit)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto blockNumber = faker->ledger()->blockNumber();
+    storage->initBlockNumber(blockNumber);
+
+    // the tx expired against the latest block is never sealed, though no block committed
+    auto expiredTx = fakeTx(cryptoSuite, faker, utcTime() + 1000, blockNumber);
+    storage->insert(expiredTx);
+    BOOST_CHECK(fetchTxsHash(storage, faker->blockFactory(), 10).empty());
+    BOOST_CHECK(waitUntil([&storage]() { return storage->size() == 0; }));
+
+    // the sealed expired tx removed before its proposal released leaves nothing to expire
+    auto sealedTx = fakeTx(cryptoSuite, faker, utcTime() + 1001, blockNumber + 1);
+    storage->insert(sealedTx);
+    auto batchHash = cryptoSuite->hashImpl()->hash(std::string("proposal"));
+    storage->batchMarkTxs(HashList{sealedTx->hash()}, blockNumber + 2, batchHash, true);
+    storage->batchRemove(blockNumber + 1, TransactionSubmitResults());
+    BOOST_CHECK(storage->exist(sealedTx->hash()));
+    BOOST_CHECK(storage->remove(sealedTx->hash()));
+    storage->batchRemove(blockNumber + 2, TransactionSubmitResults());
+    BOOST_CHECK_EQUAL(storage->size(), 0);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 0);
+    storage->stop();
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,98 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief allocation-count benchmark for the txpool containers backed by the SlabAllocator
+ * @file SlabAllocatorTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-20
+ */
+#include "bcos-txpool/txpool/utilities/SlabAllocator.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+using namespace bcos::txpool;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(slabAllocatorTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testImportAndCommitAllocations)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockNumber = faker->ledger()->blockNumber();
+    size_t rounds = 10;
+    size_t txsPerRound = 500;
+    std::vector<Transactions> roundTxs(rounds);
+    auto nonce = utcTime() + 1000;
+    for (auto& txs : roundTxs)
+    {
+        for (size_t i = 0; i < txsPerRound; i++)
+        {
+            txs.emplace_back(fakeTx(cryptoSuite, faker, nonce++, blockNumber + 10));
+        }
+    }
+    // the txs of a block are imported by the importing thread, the nodes of the expiry buckets
+    // and the sender lanes are allocated there, and freed by the committing thread once the
+    // block committed
+    auto importAndCommit = [&](Transactions const& _txs, BlockNumber _blockNumber) {
+        std::thread importer([&]() {
+            for (auto const& tx : _txs)
+            {
+                storage->insert(tx);
+            }
+        });
+        importer.join();
+        TransactionSubmitResults txsResult;
+        for (auto const& tx : _txs)
+        {
+            auto txResult = config->txResultFactory()->createTxSubmitResult();
+            txResult->setTxHash(tx->hash());
+            txsResult.emplace_back(txResult);
+        }
+        storage->batchRemove(_blockNumber, txsResult);
+        BOOST_CHECK_EQUAL(storage->size(), 0);
+    };
+    // warm up the pools with the first block
+    importAndCommit(roundTxs[0], blockNumber);
+    auto startStat = SlabPoolRegistry::instance().stat();
+    auto startT = utcTime();
+    for (size_t round = 1; round < rounds; round++)
+    {
+        importAndCommit(roundTxs[round], blockNumber);
+    }
+    auto endStat = SlabPoolRegistry::instance().stat();
+    auto systemAllocations = endStat.systemAllocations - startStat.systemAllocations;
+    auto reusedAllocations = endStat.reusedAllocations - startStat.reusedAllocations;
+    std::cout << "#### SlabAllocator benchmark: " << (rounds - 1) * txsPerRound
+              << " txs imported and committed, " << systemAllocations
+              << " nodes from the system allocator, " << reusedAllocations
+              << " reused, timecost: " << (utcTime() - startT) << "ms" << std::endl;
+    // every tx allocates at least the nodes of the expiry bucket and the sender lane
+    BOOST_CHECK(systemAllocations + reusedAllocations >= 2 * (rounds - 1) * txsPerRound);
+    // the nodes freed by the committing thread are reused by the next importing thread
+    BOOST_CHECK(systemAllocations * 10 <= reusedAllocations);
+    storage->stop();
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
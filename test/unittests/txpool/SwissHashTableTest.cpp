@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test and lookup benchmark for the SwissHashTable
+ * @file SwissHashTableTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-24
+ */
+#include "bcos-txpool/txpool/utilities/SwissHashTable.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <tbb/concurrent_unordered_map.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <unordered_map>
+
+using namespace bcos::txpool;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(swissHashTableTest, TestPromptFixture)
+
+HashType randomHash(std::mt19937_64& _random)
+{
+    HashType hash;
+    for (size_t i = 0; i < HashType::size; i++)
+    {
+        hash.data()[i] = (byte)_random();
+    }
+    return hash;
+}
+
+BOOST_AUTO_TEST_CASE(testInsertEraseFind)
+{
+    std::mt19937_64 random(1);
+    SwissHashTable<size_t> table;
+    std::unordered_map<HashType, size_t, std::hash<HashType>> expected;
+    std::vector<HashType> keys;
+    // insert twice as many as erase, with many deleted slots reclaimed
+    for (size_t i = 0; i < 100000; i++)
+    {
+        if (i % 3 != 2 || keys.empty())
+        {
+            auto hash = randomHash(random);
+            keys.emplace_back(hash);
+            BOOST_CHECK(table.emplace(hash, i).second);
+            BOOST_CHECK(!table.emplace(hash, i).second);
+            expected[hash] = i;
+            continue;
+        }
+        auto index = random() % keys.size();
+        auto hash = keys[index];
+        keys[index] = keys.back();
+        keys.pop_back();
+        BOOST_CHECK_EQUAL(table.erase(hash), 1);
+        BOOST_CHECK_EQUAL(table.erase(hash), 0);
+        expected.erase(hash);
+    }
+    BOOST_CHECK_EQUAL(table.size(), expected.size());
+    size_t traversedSize = 0;
+    for (auto const& it : table)
+    {
+        BOOST_CHECK_EQUAL(it.second, expected.at(it.first));
+        traversedSize++;
+    }
+    BOOST_CHECK_EQUAL(traversedSize, expected.size());
+    for (auto const& hash : keys)
+    {
+        auto it = table.find(hash);
+        BOOST_CHECK(it != table.end());
+        BOOST_CHECK_EQUAL(it->second, expected.at(hash));
+    }
+    for (size_t i = 0; i < 1000; i++)
+    {
+        BOOST_CHECK_EQUAL(table.count(randomHash(random)), 0);
+    }
+    table.clear();
+    BOOST_CHECK(table.empty());
+    BOOST_CHECK(table.begin() == table.end());
+}
+
+BOOST_AUTO_TEST_CASE(testLookupBenchmark)
+{
+    std::mt19937_64 random(2);
+    size_t tableSize = 200000;
+    size_t lookupRounds = 5;
+    SwissHashTable<size_t> table;
+    tbb::concurrent_unordered_map<HashType, size_t, std::hash<HashType>> tbbTable;
+    std::vector<HashType> keys;
+    for (size_t i = 0; i < tableSize; i++)
+    {
+        auto hash = randomHash(random);
+        keys.emplace_back(hash);
+        table[hash] = i;
+        tbbTable[hash] = i;
+    }
+    // half of the lookups miss
+    for (size_t i = 0; i < tableSize; i++)
+    {
+        keys.emplace_back(randomHash(random));
+    }
+    std::shuffle(keys.begin(), keys.end(), random);
+
+    size_t hitSize = 0;
+    auto startT = utcTime();
+    for (size_t round = 0; round < lookupRounds; round++)
+    {
+        for (auto const& hash : keys)
+        {
+            hitSize += table.count(hash);
+        }
+    }
+    auto swissTableTime = utcTime() - startT;
+
+    size_t tbbHitSize = 0;
+    startT = utcTime();
+    for (size_t round = 0; round < lookupRounds; round++)
+    {
+        for (auto const& hash : keys)
+        {
+            tbbHitSize += tbbTable.count(hash);
+        }
+    }
+    auto tbbTableTime = utcTime() - startT;
+    std::cout << "#### SwissHashTable benchmark: " << (lookupRounds * keys.size())
+              << " lookups, SwissHashTable timecost: " << swissTableTime
+              << "ms, concurrent_unordered_map timecost: " << tbbTableTime << "ms" << std::endl;
+    BOOST_CHECK_EQUAL(hitSize, lookupRounds * tableSize);
+    BOOST_CHECK_EQUAL(hitSize, tbbHitSize);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
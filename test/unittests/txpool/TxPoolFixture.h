@@ -31,11 +31,15 @@
 #include <bcos-framework/libprotocol/protobuf/PBBlockHeaderFactory.h>
 #include <bcos-framework/libprotocol/protobuf/PBTransactionFactory.h>
 #include <bcos-framework/libprotocol/protobuf/PBTransactionReceiptFactory.h>
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <bcos-framework/testutils/crypto/SignatureImpl.h>
 #include <bcos-framework/testutils/faker/FakeFrontService.h>
 #include <bcos-framework/testutils/faker/FakeLedger.h>
 #include <bcos-framework/testutils/faker/FakeSealer.h>
+#include <bcos-framework/testutils/protocol/FakeTransaction.h>
 #include <boost/test/unit_test.hpp>
 #include <chrono>
+#include <functional>
 #include <thread>
 
 using namespace bcos;
@@ -197,6 +201,68 @@ private:
     TransactionSync::Ptr m_sync;
 };
 
+inline TxPoolFixture::Ptr createTxPoolFaker(CryptoSuite::Ptr _cryptoSuite, int64_t _blockLimit = 15)
+{
+    auto keyPair = _cryptoSuite->signatureImpl()->generateKeyPair();
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), _cryptoSuite, "test-group", "test-chain", _blockLimit, fakeGateWay);
+    faker->init();
+    return faker;
+}
+
+inline CryptoSuite::Ptr createCryptoSuite()
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    return std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+}
+
+inline Transaction::Ptr fakeTx(CryptoSuite::Ptr _cryptoSuite, TxPoolFixture::Ptr _faker,
+    u256 const& _nonce, int64_t _blockLimit)
+{
+    return fakeTransaction(_cryptoSuite, _nonce, _blockLimit, _faker->chainId(), _faker->groupId());
+}
+
+// fake the tx sent by the given sender
+inline Transaction::Ptr fakeSenderTx(CryptoSuite::Ptr _cryptoSuite, TxPoolFixture::Ptr _faker,
+    KeyPairInterface::Ptr _sender, u256 const& _nonce, int64_t _blockLimit)
+{
+    std::string inputStr = "testTransaction";
+    return fakeTransaction(_cryptoSuite, _sender, bytes(20, 1),
+        bytes(inputStr.begin(), inputStr.end()), _nonce, _blockLimit, _faker->chainId(),
+        _faker->groupId());
+}
+
+inline HashList fetchTxsHash(TxPoolStorageInterface::Ptr _storage,
+    BlockFactory::Ptr _blockFactory, size_t _txsLimit, bool _avoidDuplicate = true)
+{
+    auto txsList = _blockFactory->createBlock();
+    auto sysTxsList = _blockFactory->createBlock();
+    _storage->batchFetchTxs(txsList, sysTxsList, _txsLimit, nullptr, _avoidDuplicate);
+    HashList txsHash;
+    for (size_t i = 0; i < sysTxsList->transactionsMetaDataSize(); i++)
+    {
+        txsHash.emplace_back(sysTxsList->transactionMetaData(i)->hash());
+    }
+    for (size_t i = 0; i < txsList->transactionsMetaDataSize(); i++)
+    {
+        txsHash.emplace_back(txsList->transactionMetaData(i)->hash());
+    }
+    return txsHash;
+}
+
+// wait until the condition holds, return false if it still fails after _timeout ms
+inline bool waitUntil(std::function<bool()> const& _condition, int64_t _timeout = 10000)
+{
+    auto startT = utcTime();
+    while (!_condition() && (utcTime() - startT <= _timeout))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return _condition();
+}
+
 inline void checkTxSubmit(TxPoolInterface::Ptr _txpool, TxPoolStorageInterface::Ptr _storage,
     Transaction::Ptr _tx, HashType const& _expectedTxHash, uint32_t _expectedStatus,
     size_t expectedTxSize, bool _needWaitResult = true, bool _waitNothing = false,
@@ -428,6 +428,15 @@ void txPoolInitAndSubmitTransactionTest(bool _sm, CryptoSuite::Ptr _cryptoSuite)
     txpoolConfig->setPoolLimit(importedTxNum);
     checkTxSubmit(txpool, txpoolStorage, tx, tx->hash(), (uint32_t)TransactionStatus::TxPoolIsFull,
         importedTxNum);
+    // the memory of the txpool is full
+    BOOST_CHECK(txpoolStorage->memorySize() > 0);
+    BOOST_CHECK(txpoolStorage->peakMemorySize() >= txpoolStorage->memorySize());
+    txpoolConfig->setPoolLimit(importedTxNum + 1);
+    txpoolConfig->setPoolMemoryLimit(txpoolStorage->memorySize());
+    checkTxSubmit(txpool, txpoolStorage, tx, tx->hash(), (uint32_t)TransactionStatus::TxPoolIsFull,
+        importedTxNum);
+    txpoolConfig->setPoolMemoryLimit(0);
+    txpoolConfig->setPoolLimit(importedTxNum);
 
     // case10: malformed transaction
     auto encodedData = tx->encode();
@@ -516,6 +525,686 @@ BOOST_AUTO_TEST_CASE(fillWithSubmit)
     //     });
     // fillPromise.get_future().get();
 }
+BOOST_AUTO_TEST_CASE(testUnsealedTxsIndex)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    // the txs of the same sender are sealed in the order of the import time
+    auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+    Transactions txs;
+    for (int64_t importTime = 1; importTime <= 10; importTime++)
+    {
+        auto tx =
+            fakeSenderTx(cryptoSuite, faker, sender, utcTime() + 1000 + importTime, blockLimit);
+        tx->setImportTime(importTime);
+        storage->insert(tx);
+        txs.emplace_back(tx);
+    }
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 10);
+
+    // seal
+    auto sealedTxs = fetchTxsHash(storage, faker->blockFactory(), 4);
+    BOOST_REQUIRE_EQUAL(sealedTxs.size(), 4);
+    for (size_t i = 0; i < sealedTxs.size(); i++)
+    {
+        BOOST_CHECK(sealedTxs[i] == txs[i]->hash());
+        BOOST_CHECK(txs[i]->sealed());
+    }
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 6);
+
+    // unseal
+    storage->batchMarkTxs(HashList{txs[0]->hash(), txs[1]->hash()},
+        faker->ledger()->blockNumber() + 1, HashType(), false);
+    BOOST_CHECK(!txs[0]->sealed());
+    BOOST_CHECK(!txs[1]->sealed());
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 8);
+
+    // remove a sealed tx and an unsealed tx
+    BOOST_CHECK(storage->remove(txs[2]->hash()) == txs[2]);
+    BOOST_CHECK(storage->remove(txs[5]->hash()) == txs[5]);
+    BOOST_CHECK_EQUAL(storage->size(), 8);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 7);
+
+    // the index holds exactly the unsealed txs, in the order of the import time
+    sealedTxs = fetchTxsHash(storage, faker->blockFactory(), 100);
+    HashList expectedTxs;
+    for (auto i : {0, 1, 4, 6, 7, 8, 9})
+    {
+        expectedTxs.emplace_back(txs[i]->hash());
+    }
+    BOOST_CHECK(sealedTxs == expectedTxs);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 0);
+    BOOST_CHECK(fetchTxsHash(storage, faker->blockFactory(), 100).empty());
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testShardSealedTxsSize)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    config->setTxsShardNum(4);
+    // mark the txs of the shards in parallel
+    config->setBulkParallelThreshold(1);
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    HashList txsHash;
+    for (size_t i = 0; i < 64; i++)
+    {
+        auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit);
+        storage->insert(tx);
+        txs.emplace_back(tx);
+        txsHash.emplace_back(tx->hash());
+    }
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 64);
+
+    // the sealed txs are counted by the shards they belong to
+    auto batchId = faker->ledger()->blockNumber() + 1;
+    auto batchHash = cryptoSuite->hashImpl()->hash(std::string("proposal"));
+    HashList sealedTxs(txsHash.begin(), txsHash.begin() + 40);
+    storage->batchMarkTxs(sealedTxs, batchId, batchHash, true);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 24);
+    // marking the sealed txs again changes nothing
+    storage->batchMarkTxs(sealedTxs, batchId, batchHash, true);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 24);
+
+    // removing the sealed txs drops their counts
+    for (size_t i = 0; i < 10; i++)
+    {
+        storage->remove(txsHash[i]);
+    }
+    BOOST_CHECK_EQUAL(storage->size(), 54);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 24);
+
+    // all the kept txs are unsealed once the proposal released
+    BOOST_CHECK_EQUAL(storage->unsealProposal(batchId, batchHash), 30);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 54);
+    for (size_t i = 10; i < txs.size(); i++)
+    {
+        BOOST_CHECK(!txs[i]->sealed());
+    }
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testTxsFilter)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto hashImpl = cryptoSuite->hashImpl();
+    size_t hashSize = 1000;
+    CountingBloomFilter filter(hashSize);
+    HashList hashList;
+    for (size_t i = 0; i < hashSize; i++)
+    {
+        hashList.emplace_back(hashImpl->hash(std::to_string(i)));
+        filter.insert(hashList.back());
+    }
+    // the hash inserted twice is kept after removed once
+    filter.insert(hashList[0]);
+    filter.remove(hashList[0]);
+    for (auto const& hash : hashList)
+    {
+        BOOST_CHECK(filter.mayContain(hash));
+    }
+    // no false negatives after the other hashes removed
+    size_t falsePositives = 0;
+    for (size_t i = 0; i < hashSize; i++)
+    {
+        if (i % 2 == 0)
+        {
+            continue;
+        }
+        filter.remove(hashList[i]);
+    }
+    for (size_t i = 0; i < hashSize; i++)
+    {
+        if (i % 2 == 0)
+        {
+            BOOST_CHECK(filter.mayContain(hashList[i]));
+            continue;
+        }
+        falsePositives += filter.mayContain(hashList[i]);
+    }
+    // the removed hashes are deleted from the filter, except the rare false positives
+    BOOST_CHECK(falsePositives < hashSize / 20);
+
+    // the storage answers by the filter and the table
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    for (size_t i = 0; i < 100; i++)
+    {
+        txs.emplace_back(fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit));
+        storage->insert(txs.back());
+    }
+    HashList removedTxs;
+    for (size_t i = 0; i < txs.size(); i += 2)
+    {
+        storage->remove(txs[i]->hash());
+        removedTxs.emplace_back(txs[i]->hash());
+    }
+    for (size_t i = 0; i < txs.size(); i++)
+    {
+        BOOST_CHECK(storage->exist(txs[i]->hash()) == (i % 2 == 1));
+    }
+    HashList txsHash;
+    for (auto const& tx : txs)
+    {
+        txsHash.emplace_back(tx->hash());
+    }
+    auto peer = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    BOOST_CHECK(*(storage->filterUnknownTxs(txsHash, peer)) == removedTxs);
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testNotifyTxsResultInChunks)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    config->setNotifierWorkerNum(4);
+    auto storage = std::make_shared<MemoryStorage>(config);
+    // the results of the txs without callback are notified in bulk
+    Mutex x_notifiedTxs;
+    std::map<HashType, size_t> notifiedTxs;
+    std::atomic<size_t> notifiedSize = {0};
+    auto onNotified = [&](HashType const& _txHash) {
+        Guard l(x_notifiedTxs);
+        notifiedTxs[_txHash]++;
+        notifiedSize++;
+    };
+    std::atomic<size_t> bulkNotifiedTimes = {0};
+    storage->registerTxsResultNotifier([&](TransactionSubmitResultsPtr _txsResult) {
+        bulkNotifiedTimes++;
+        for (auto const& txResult : *_txsResult)
+        {
+            onNotified(txResult->txHash());
+        }
+    });
+    // the txs are split into the chunks of the notifier workers
+    size_t txsSize = 2000;
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    TransactionSubmitResults txsResult;
+    for (size_t i = 0; i < txsSize; i++)
+    {
+        auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit);
+        if (i % 2 == 0)
+        {
+            tx->setSubmitCallback([&onNotified, txHash = tx->hash()](Error::Ptr,
+                                      TransactionSubmitResult::Ptr) { onNotified(txHash); });
+        }
+        storage->insert(tx);
+        auto txResult = config->txResultFactory()->createTxSubmitResult();
+        txResult->setTxHash(tx->hash());
+        txsResult.emplace_back(txResult);
+    }
+    storage->batchRemove(faker->ledger()->blockNumber() + 1, txsResult);
+    BOOST_CHECK_EQUAL(storage->size(), 0);
+    BOOST_CHECK(waitUntil([&notifiedSize, txsSize]() { return notifiedSize >= txsSize; }));
+    // no result is notified twice
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(notifiedSize.load(), txsSize);
+    BOOST_CHECK(bulkNotifiedTimes > 1);
+    Guard l(x_notifiedTxs);
+    BOOST_CHECK_EQUAL(notifiedTxs.size(), txsSize);
+    for (auto const& txResult : txsResult)
+    {
+        BOOST_CHECK_EQUAL(notifiedTxs[txResult->txHash()], 1);
+    }
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testResetAfterMarkAllTxs)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto txpool = faker->txpool();
+    auto storage = txpool->txpoolStorage();
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    for (size_t i = 0; i < 10; i++)
+    {
+        txs.emplace_back(fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit));
+        storage->insert(txs.back());
+    }
+    // some txs are sealed by the proposal
+    auto batchHash = cryptoSuite->hashImpl()->hash(std::string("proposal"));
+    storage->batchMarkTxs(HashList{txs[0]->hash(), txs[1]->hash()},
+        faker->ledger()->blockNumber() + 1, batchHash, true);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 8);
+
+    // seal all
+    storage->batchMarkAllTxs(true);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 0);
+    for (auto const& tx : txs)
+    {
+        BOOST_CHECK(tx->sealed());
+    }
+    BOOST_CHECK(fetchTxsHash(storage, faker->blockFactory(), 100).empty());
+
+    // all the txs are unsealed by the reset
+    bool reset = false;
+    txpool->asyncResetTxPool([&reset](Error::Ptr _error) {
+        BOOST_CHECK(_error == nullptr);
+        reset = true;
+    });
+    BOOST_CHECK(reset);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), txs.size());
+    for (auto const& tx : txs)
+    {
+        BOOST_CHECK(!tx->sealed());
+    }
+    BOOST_CHECK_EQUAL(fetchTxsHash(storage, faker->blockFactory(), 100).size(), txs.size());
+}
+BOOST_AUTO_TEST_CASE(testTxReferencedByProposals)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    for (size_t i = 0; i < 3; i++)
+    {
+        txs.emplace_back(fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit));
+        storage->insert(txs.back());
+    }
+    auto hashImpl = cryptoSuite->hashImpl();
+    auto batchId = faker->ledger()->blockNumber() + 1;
+    auto proposalA = hashImpl->hash(std::string("proposalA"));
+    auto proposalB = hashImpl->hash(std::string("proposalB"));
+    // the tx is referenced by the competing proposals of the same height
+    auto const& tx = txs[0];
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalA, true);
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalB, true);
+    BOOST_CHECK(tx->sealed());
+    BOOST_CHECK_EQUAL(storage->fetchProposalTxs(batchId, proposalA)->size(), 1);
+    BOOST_CHECK_EQUAL(storage->fetchProposalTxs(batchId, proposalB)->size(), 1);
+
+    // kept sealed until both proposals released
+    BOOST_CHECK_EQUAL(storage->unsealProposal(batchId, proposalA), 0);
+    BOOST_CHECK(tx->sealed());
+    BOOST_CHECK(storage->fetchProposalTxs(batchId, proposalA)->empty());
+    BOOST_CHECK_EQUAL(storage->fetchProposalTxs(batchId, proposalB)->size(), 1);
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 2);
+    BOOST_CHECK_EQUAL(storage->unsealProposal(batchId, proposalB), 1);
+    BOOST_CHECK(!tx->sealed());
+    BOOST_CHECK_EQUAL(storage->unSealedTxsSize(), 3);
+
+    // unmarking one of the proposals keeps the tx sealed as well
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalA, true);
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalB, true);
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalA, false);
+    BOOST_CHECK(tx->sealed());
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalB, false);
+    BOOST_CHECK(!tx->sealed());
+
+    // only the proposals above the given height are released
+    storage->batchMarkTxs(HashList{txs[1]->hash()}, batchId, proposalA, true);
+    storage->batchMarkTxs(HashList{txs[2]->hash()}, batchId + 1, proposalB, true);
+    BOOST_CHECK_EQUAL(storage->unsealProposalsAbove(batchId), 1);
+    BOOST_CHECK(txs[1]->sealed());
+    BOOST_CHECK(!txs[2]->sealed());
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testEnforceSubmitCompetingProposal)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000, blockLimit);
+    storage->insert(tx);
+    auto hashImpl = cryptoSuite->hashImpl();
+    auto batchId = faker->ledger()->blockNumber() + 1;
+    auto proposalA = hashImpl->hash(std::string("proposalA"));
+    auto proposalB = hashImpl->hash(std::string("proposalB"));
+    storage->batchMarkTxs(HashList{tx->hash()}, batchId, proposalA, true);
+
+    // the tx of the proposal received from the leader
+    auto proposalTx = [&](BlockNumber _batchId, HashType const& _batchHash) {
+        auto encodedData = tx->encode();
+        auto receivedTx = config->txFactory()->createTransaction(encodedData, false);
+        receivedTx->setBatchId(_batchId);
+        receivedTx->setBatchHash(_batchHash);
+        return receivedTx;
+    };
+    // the same proposal
+    BOOST_CHECK(storage->submitTransaction(proposalTx(batchId, proposalA), nullptr, true) ==
+                TransactionStatus::None);
+    // the competing proposal of the same height is accepted
+    BOOST_CHECK(storage->submitTransaction(proposalTx(batchId, proposalB), nullptr, true) ==
+                TransactionStatus::None);
+    BOOST_CHECK_EQUAL(storage->size(), 1);
+    BOOST_CHECK_EQUAL(storage->fetchProposalTxs(batchId, proposalB)->size(), 1);
+    BOOST_CHECK_EQUAL(storage->unsealProposal(batchId, proposalA), 0);
+    BOOST_CHECK(tx->sealed());
+    // the proposal of another height is rejected
+    auto proposalC = hashImpl->hash(std::string("proposalC"));
+    BOOST_CHECK(storage->submitTransaction(proposalTx(batchId + 1, proposalC), nullptr, true) ==
+                TransactionStatus::AlreadyInTxPool);
+    BOOST_CHECK(storage->fetchProposalTxs(batchId + 1, proposalC)->empty());
+    BOOST_CHECK_EQUAL(storage->unsealProposal(batchId, proposalB), 1);
+    BOOST_CHECK(!tx->sealed());
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testSealWithConflictGroups)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    // the txs sent to three contracts, interleaved
+    std::vector<bytes> contracts = {bytes(20, 1), bytes(20, 2), bytes(20, 3)};
+    std::vector<size_t> contractIndexes = {1, 0, 2, 0, 2, 0};
+    std::string inputStr = "testTransaction";
+    auto nonce = utcTime() + 1000;
+    for (auto index : contractIndexes)
+    {
+        auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+        auto tx = fakeTransaction(cryptoSuite, sender, contracts[index],
+            bytes(inputStr.begin(), inputStr.end()), nonce++, blockLimit, faker->chainId(),
+            faker->groupId());
+        storage->insert(tx);
+    }
+    auto blockFactory = faker->txpool()->txpoolConfig()->blockFactory();
+    auto fetchWithConflictGroups = [&](TxsConflictGroupsPtr _conflictGroups) {
+        auto txsList = blockFactory->createBlock();
+        auto sysTxsList = blockFactory->createBlock();
+        storage->batchFetchTxs(txsList, sysTxsList, 100, nullptr, true, _conflictGroups);
+        return txsList;
+    };
+
+    // not grouped when conflictAwareSealing disabled
+    config->setConflictAwareSealing(false);
+    auto conflictGroups = std::make_shared<TxsConflictGroups>();
+    auto txsList = fetchWithConflictGroups(conflictGroups);
+    BOOST_CHECK_EQUAL(txsList->transactionsMetaDataSize(), contractIndexes.size());
+    BOOST_CHECK(conflictGroups->empty());
+    storage->batchMarkAllTxs(false);
+
+    // the groups are sealed contiguously, the largest first
+    config->setConflictAwareSealing(true);
+    txsList = fetchWithConflictGroups(conflictGroups);
+    BOOST_REQUIRE_EQUAL(txsList->transactionsMetaDataSize(), contractIndexes.size());
+    BOOST_REQUIRE_EQUAL(conflictGroups->size(), 3);
+    std::vector<size_t> expectedSizes = {3, 2, 1};
+    std::set<std::string> groupContracts;
+    size_t offset = 0;
+    for (size_t i = 0; i < conflictGroups->size(); i++)
+    {
+        auto const& group = (*conflictGroups)[i];
+        BOOST_CHECK_EQUAL(group.offset, offset);
+        BOOST_CHECK_EQUAL(group.size, expectedSizes[i]);
+        groupContracts.insert(group.to);
+        // the sealed txs in the group access the contract of the group
+        for (auto j = group.offset; j < group.offset + group.size; j++)
+        {
+            BOOST_CHECK(txsList->transactionMetaData(j)->to() == group.to);
+        }
+        offset += group.size;
+    }
+    BOOST_CHECK_EQUAL(groupContracts.size(), contracts.size());
+    BOOST_CHECK_EQUAL(offset, txsList->transactionsMetaDataSize());
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testFetchResumesFromLastSender)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    // two txs for every sender, the senders ordered as their lanes
+    std::map<std::string, HashList> sendersTxs;
+    auto nonce = utcTime() + 1000;
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+        for (size_t j = 0; j < 2; j++)
+        {
+            auto tx = fakeSenderTx(cryptoSuite, faker, sender, nonce++, blockLimit);
+            tx->setImportTime(j);
+            storage->insert(tx);
+            sendersTxs[std::string(tx->sender())].emplace_back(tx->hash());
+        }
+    }
+    std::vector<HashList> lanes;
+    for (auto const& it : sendersTxs)
+    {
+        lanes.emplace_back(it.second);
+    }
+    auto blockFactory = config->blockFactory();
+
+    // every fetch of the sealer continues from the sender after the one where the last fetch
+    // stopped, instead of the first sender
+    BOOST_CHECK(fetchTxsHash(storage, blockFactory, 2) == HashList({lanes[0][0], lanes[1][0]}));
+    BOOST_CHECK(fetchTxsHash(storage, blockFactory, 2) == HashList({lanes[2][0], lanes[0][1]}));
+    BOOST_CHECK(fetchTxsHash(storage, blockFactory, 2) == HashList({lanes[1][1], lanes[2][1]}));
+    BOOST_CHECK(fetchTxsHash(storage, blockFactory, 2).empty());
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testBatchSubmitTransactions)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto config = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<MemoryStorage>(config);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    auto nonce = utcTime() + 1000;
+    auto encodeTx = [](Transaction::Ptr _tx) {
+        auto encodedData = _tx->encode();
+        return std::make_shared<bytes>(encodedData.begin(), encodedData.end());
+    };
+    // submit the txs, return the statuses notified by the callbacks
+    auto batchSubmit = [&](std::vector<bytesPointer> const& _txsData) {
+        auto notifiedStatus = std::make_shared<std::vector<int32_t>>(_txsData.size(), -1);
+        std::vector<TxSubmitCallback> callbacks;
+        for (size_t i = 0; i < _txsData.size(); i++)
+        {
+            callbacks.emplace_back(
+                [notifiedStatus, i](Error::Ptr, TransactionSubmitResult::Ptr _result) {
+                    (*notifiedStatus)[i] = _result->status();
+                });
+        }
+        auto results = storage->batchSubmitTransactions(_txsData, callbacks);
+        BOOST_REQUIRE_EQUAL(results->size(), _txsData.size());
+        // the rejected txs are notified at once
+        for (size_t i = 0; i < _txsData.size(); i++)
+        {
+            if ((*results)[i] != TransactionStatus::None)
+            {
+                BOOST_CHECK_EQUAL((*notifiedStatus)[i], (int32_t)(*results)[i]);
+            }
+            else
+            {
+                BOOST_CHECK_EQUAL((*notifiedStatus)[i], -1);
+            }
+        }
+        return results;
+    };
+
+    auto pooledTx = fakeTx(cryptoSuite, faker, nonce++, blockLimit);
+    BOOST_CHECK((*batchSubmit({encodeTx(pooledTx)}))[0] == TransactionStatus::None);
+    // the valid, malformed and duplicate txs
+    auto validTx = fakeTx(cryptoSuite, faker, nonce++, blockLimit);
+    auto duplicateTx = fakeTx(cryptoSuite, faker, nonce++, blockLimit);
+    auto results = batchSubmit({encodeTx(validTx), std::make_shared<bytes>(10, 1),
+        encodeTx(pooledTx), encodeTx(duplicateTx), encodeTx(duplicateTx)});
+    BOOST_CHECK((*results)[0] == TransactionStatus::None);
+    BOOST_CHECK((*results)[1] == TransactionStatus::Malform);
+    BOOST_CHECK((*results)[2] == TransactionStatus::AlreadyInTxPool);
+    // only one of the duplicate txs in the same batch is accepted
+    BOOST_CHECK(((*results)[3] == TransactionStatus::None) !=
+                ((*results)[4] == TransactionStatus::None));
+    BOOST_CHECK_EQUAL(storage->size(), 3);
+    BOOST_CHECK(storage->exist(validTx->hash()));
+    BOOST_CHECK(storage->exist(duplicateTx->hash()));
+
+    // the batch never exceeds the pool limit
+    config->setPoolLimit(storage->size() + 2);
+    Transactions txs;
+    std::vector<bytesPointer> txsData;
+    for (size_t i = 0; i < 4; i++)
+    {
+        txs.emplace_back(fakeTx(cryptoSuite, faker, nonce++, blockLimit));
+        txsData.emplace_back(encodeTx(txs.back()));
+    }
+    results = batchSubmit(txsData);
+    std::vector<bytesPointer> rejectedTxsData;
+    for (size_t i = 0; i < txs.size(); i++)
+    {
+        if ((*results)[i] == TransactionStatus::TxPoolIsFull)
+        {
+            rejectedTxsData.emplace_back(txsData[i]);
+            continue;
+        }
+        BOOST_CHECK((*results)[i] == TransactionStatus::None);
+    }
+    BOOST_CHECK_EQUAL(rejectedTxsData.size(), 2);
+    BOOST_CHECK_EQUAL(storage->size(), config->poolLimit());
+    // the nonces of the rejected txs are released, they can be submitted again
+    config->setPoolLimit(storage->size() + 2);
+    results = batchSubmit(rejectedTxsData);
+    BOOST_CHECK((*results)[0] == TransactionStatus::None);
+    BOOST_CHECK((*results)[1] == TransactionStatus::None);
+    BOOST_CHECK_EQUAL(storage->size(), config->poolLimit());
+    storage->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testSubmitBatchWithBoundedQueue)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto txpool = faker->txpool();
+    // the batch is accepted only when nothing queued
+    txpool->txpoolConfig()->setSubmitQueueCapacity(1);
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    auto nonce = utcTime() + 1000;
+    size_t batchSize = 20;
+    size_t txsSizePerBatch = 2;
+    // Note: the callbacks of the accepted txs may be called after the test, never capture the
+    // locals by reference
+    auto submittedBatchSize = std::make_shared<std::atomic<size_t>>(0);
+    auto rejectedBatchSize = std::make_shared<std::atomic<size_t>>(0);
+    auto unexpectedResultSize = std::make_shared<std::atomic<size_t>>(0);
+    auto rejectedTxsSize = std::make_shared<std::atomic<size_t>>(0);
+    for (size_t i = 0; i < batchSize; i++)
+    {
+        auto txsData = std::make_shared<std::vector<bytesPointer>>();
+        auto callbacks = std::make_shared<std::vector<TxSubmitCallback>>();
+        for (size_t j = 0; j < txsSizePerBatch; j++)
+        {
+            auto tx = fakeTx(cryptoSuite, faker, nonce++, blockLimit);
+            auto encodedData = tx->encode();
+            txsData->emplace_back(std::make_shared<bytes>(encodedData.begin(), encodedData.end()));
+            callbacks->emplace_back([rejectedTxsSize, unexpectedResultSize, txHash = tx->hash()](
+                                        Error::Ptr _error, TransactionSubmitResult::Ptr _result) {
+                if (_error && _result->status() == (uint32_t)TransactionStatus::TxPoolIsFull)
+                {
+                    (*rejectedTxsSize)++;
+                    // the rejected tx is notified with its hash
+                    if (_result->txHash() != txHash)
+                    {
+                        (*unexpectedResultSize)++;
+                    }
+                }
+            });
+        }
+        txpool->asyncSubmitBatch(txsData, callbacks,
+            [submittedBatchSize, rejectedBatchSize, unexpectedResultSize, txsSizePerBatch](
+                Error::Ptr _error, std::shared_ptr<std::vector<TransactionStatus>> _results) {
+                // the batch is either submitted or rejected as a whole
+                if (_error || _results->size() != txsSizePerBatch ||
+                    std::any_of(_results->begin(), _results->end(),
+                        [&_results](TransactionStatus _status) {
+                            return _status != (*_results)[0];
+                        }))
+                {
+                    (*unexpectedResultSize)++;
+                }
+                else if ((*_results)[0] == TransactionStatus::TxPoolIsFull)
+                {
+                    (*rejectedBatchSize)++;
+                }
+                (*submittedBatchSize)++;
+            });
+    }
+    BOOST_CHECK(waitUntil([&]() { return *submittedBatchSize == batchSize; }));
+    BOOST_CHECK_EQUAL(unexpectedResultSize->load(), 0);
+    // the first batch is never rejected
+    BOOST_CHECK(*rejectedBatchSize < batchSize);
+    BOOST_CHECK_EQUAL(rejectedTxsSize->load(), rejectedBatchSize->load() * txsSizePerBatch);
+    BOOST_CHECK_EQUAL(txpool->txpoolStorage()->size(),
+        (batchSize - rejectedBatchSize->load()) * txsSizePerBatch);
+    txpool->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testSubmitBatchAtStop)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto txpool = faker->txpool();
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    auto nonce = utcTime() + 1000;
+
+    // the batch without data is failed as a whole
+    auto emptyBatchError = std::make_shared<std::atomic_bool>(false);
+    txpool->asyncSubmitBatch(nullptr, nullptr,
+        [emptyBatchError](Error::Ptr _error, std::shared_ptr<std::vector<TransactionStatus>>) {
+            *emptyBatchError = (_error != nullptr);
+        });
+    BOOST_CHECK(*emptyBatchError);
+
+    // every batch is notified exactly once, either submitted by the worker or rejected by stop
+    size_t batchSize = 100;
+    size_t txsSizePerBatch = 10;
+    auto notifiedBatchSize = std::make_shared<std::atomic<size_t>>(0);
+    auto rejectedBatchSize = std::make_shared<std::atomic<size_t>>(0);
+    auto notifiedTxsSize = std::make_shared<std::atomic<size_t>>(0);
+    auto unexpectedResultSize = std::make_shared<std::atomic<size_t>>(0);
+    for (size_t i = 0; i < batchSize; i++)
+    {
+        auto txsData = std::make_shared<std::vector<bytesPointer>>();
+        auto callbacks = std::make_shared<std::vector<TxSubmitCallback>>();
+        for (size_t j = 0; j < txsSizePerBatch; j++)
+        {
+            auto tx = fakeTx(cryptoSuite, faker, nonce++, blockLimit);
+            auto encodedData = tx->encode();
+            txsData->emplace_back(std::make_shared<bytes>(encodedData.begin(), encodedData.end()));
+            callbacks->emplace_back([notifiedTxsSize, unexpectedResultSize, txHash = tx->hash()](
+                                        Error::Ptr, TransactionSubmitResult::Ptr _result) {
+                (*notifiedTxsSize)++;
+                if (_result->txHash() != txHash)
+                {
+                    (*unexpectedResultSize)++;
+                }
+            });
+        }
+        txpool->asyncSubmitBatch(txsData, callbacks,
+            [notifiedBatchSize, rejectedBatchSize](
+                Error::Ptr _error, std::shared_ptr<std::vector<TransactionStatus>> _results) {
+                if (!_error && _results && !_results->empty() &&
+                    (*_results)[0] == TransactionStatus::TxPoolIsFull)
+                {
+                    (*rejectedBatchSize)++;
+                }
+                (*notifiedBatchSize)++;
+            });
+    }
+    txpool->stop();
+    // the rejected batches are notified by stop synchronously
+    auto submittedBatchSize = batchSize - rejectedBatchSize->load();
+    BOOST_CHECK(waitUntil([&]() { return *notifiedBatchSize == batchSize; }));
+    BOOST_CHECK_EQUAL(unexpectedResultSize->load(), 0);
+    BOOST_CHECK_EQUAL(txpool->txpoolStorage()->size(), submittedBatchSize * txsSizePerBatch);
+    // the rejected txs are notified with the callbacks
+    BOOST_CHECK(notifiedTxsSize->load() >= rejectedBatchSize->load() * txsSizePerBatch);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the eviction policies of the full txpool
+ * @file TxsEvictionPolicyTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-28
+ */
+#include "bcos-txpool/txpool/storage/TxsEvictionPolicy.h"
+#include <bcos-framework/interfaces/crypto/CryptoSuite.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-framework/testutils/crypto/HashImpl.h>
+#include <bcos-framework/testutils/crypto/SignatureImpl.h>
+#include <bcos-framework/testutils/protocol/FakeTransaction.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(txsEvictionPolicyTest, TestPromptFixture)
+
+CryptoSuite::Ptr createEvictionCryptoSuite()
+{
+    auto hashImpl = std::make_shared<Keccak256Hash>();
+    auto signatureImpl = std::make_shared<Secp256k1SignatureImpl>();
+    return std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+}
+
+Transaction::Ptr fakeEvictionTx(CryptoSuite::Ptr _cryptoSuite, KeyPairInterface::Ptr _sender,
+    int64_t _importTime, bool _systemTx = false)
+{
+    std::string inputStr = "testTransaction";
+    auto tx = fakeTransaction(_cryptoSuite, _sender, bytes(20, 1),
+        bytes(inputStr.begin(), inputStr.end()), utcTime() + _importTime, 100, "chainId",
+        "groupId");
+    tx->setImportTime(_importTime);
+    tx->setSystemTx(_systemTx);
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(testImportTimePolicies)
+{
+    auto cryptoSuite = createEvictionCryptoSuite();
+    auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+    auto oldestFirst = createTxsEvictionPolicy(TxsEvictionPolicyType::OldestFirst);
+    auto lowestPriorityFirst = createTxsEvictionPolicy(TxsEvictionPolicyType::LowestPriorityFirst);
+    BOOST_CHECK(createTxsEvictionPolicy(TxsEvictionPolicyType::None) == nullptr);
+
+    Transactions txs;
+    for (int64_t importTime = 1; importTime <= 3; importTime++)
+    {
+        txs.emplace_back(fakeEvictionTx(cryptoSuite, sender, importTime));
+    }
+    // the system tx is older than all, but never tracked
+    auto systemTx = fakeEvictionTx(cryptoSuite, sender, 0, true);
+    for (auto const& policy : {oldestFirst, lowestPriorityFirst})
+    {
+        for (auto const& tx : txs)
+        {
+            policy->onInsert(tx);
+        }
+        policy->onInsert(systemTx);
+    }
+    auto incomingTx = fakeEvictionTx(cryptoSuite, sender, 4);
+    auto incomingSystemTx = fakeEvictionTx(cryptoSuite, sender, 5, true);
+
+    // OldestFirst: every incoming tx evicts the oldest normal tx
+    BOOST_CHECK(oldestFirst->selectVictim(incomingTx) == txs[0]);
+    BOOST_CHECK(oldestFirst->selectVictim(incomingSystemTx) == txs[0]);
+    oldestFirst->onRemove(txs[0]);
+    BOOST_CHECK(oldestFirst->selectVictim(incomingTx) == txs[1]);
+
+    // LowestPriorityFirst: only the system tx evicts the newest normal tx
+    BOOST_CHECK(lowestPriorityFirst->selectVictim(incomingTx) == nullptr);
+    BOOST_CHECK(lowestPriorityFirst->selectVictim(incomingSystemTx) == txs[2]);
+    lowestPriorityFirst->onRemove(txs[2]);
+    BOOST_CHECK(lowestPriorityFirst->selectVictim(incomingSystemTx) == txs[1]);
+
+    // the policies tracking only the system tx select no victim
+    for (auto const& policy : {oldestFirst, lowestPriorityFirst})
+    {
+        for (auto const& tx : txs)
+        {
+            policy->onRemove(tx);
+        }
+        BOOST_CHECK(policy->selectVictim(incomingSystemTx) == nullptr);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSenderOverflowFirst)
+{
+    auto cryptoSuite = createEvictionCryptoSuite();
+    auto policy = createTxsEvictionPolicy(TxsEvictionPolicyType::SenderOverflowFirst);
+    auto overflowSender = cryptoSuite->signatureImpl()->generateKeyPair();
+    auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+    Transactions overflowSenderTxs;
+    for (int64_t importTime = 1; importTime <= 3; importTime++)
+    {
+        overflowSenderTxs.emplace_back(fakeEvictionTx(cryptoSuite, overflowSender, importTime));
+        policy->onInsert(overflowSenderTxs.back());
+    }
+    policy->onInsert(fakeEvictionTx(cryptoSuite, sender, 4));
+
+    // the tx of the sender with fewer pending txs evicts the newest tx of the overflow sender
+    BOOST_CHECK(policy->selectVictim(fakeEvictionTx(cryptoSuite, sender, 5)) ==
+                overflowSenderTxs[2]);
+    auto newSender = cryptoSuite->signatureImpl()->generateKeyPair();
+    BOOST_CHECK(policy->selectVictim(fakeEvictionTx(cryptoSuite, newSender, 5)) ==
+                overflowSenderTxs[2]);
+    // the overflow sender can not make room for itself
+    BOOST_CHECK(policy->selectVictim(fakeEvictionTx(cryptoSuite, overflowSender, 5)) == nullptr);
+    // the system tx always makes room
+    BOOST_CHECK(policy->selectVictim(fakeEvictionTx(cryptoSuite, overflowSender, 5, true)) ==
+                overflowSenderTxs[2]);
+
+    // the sender is not overflowed once its txs removed
+    policy->onRemove(overflowSenderTxs[2]);
+    policy->onRemove(overflowSenderTxs[1]);
+    BOOST_CHECK(policy->selectVictim(fakeEvictionTx(cryptoSuite, sender, 5)) == nullptr);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
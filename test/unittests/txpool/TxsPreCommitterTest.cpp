@@ -0,0 +1,213 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the group commit of the TxsPreCommitter
+ * @file TxsPreCommitterTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-29
+ */
+#include "bcos-txpool/txpool/storage/TxsPreCommitter.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+// record the stored batches, and fail the first _failedTimes calls
+class FakeStoreLedger : public FakeLedger
+{
+public:
+    using Ptr = std::shared_ptr<FakeStoreLedger>;
+    FakeStoreLedger(BlockFactory::Ptr _blockFactory, size_t _failedTimes)
+      : FakeLedger(_blockFactory, 20, 10, 10), m_failedTimes(_failedTimes)
+    {}
+
+    void asyncStoreTransactions(std::shared_ptr<std::vector<bytesConstPtr>> _txToStore,
+        HashListPtr _txHashList, std::function<void(Error::Ptr)> _onTxStored) override
+    {
+        bool stored = false;
+        {
+            Guard l(x_storedTxs);
+            m_calledTimes++;
+            stored = (m_calledTimes > m_failedTimes) && (_txToStore->size() == _txHashList->size());
+            if (stored)
+            {
+                m_storedBatches.emplace_back(*_txHashList);
+            }
+        }
+        if (stored)
+        {
+            _onTxStored(nullptr);
+            return;
+        }
+        _onTxStored(std::make_shared<Error>(-1, "fake store failed"));
+    }
+
+    size_t calledTimes()
+    {
+        Guard l(x_storedTxs);
+        return m_calledTimes;
+    }
+    std::vector<HashList> storedBatches()
+    {
+        Guard l(x_storedTxs);
+        return m_storedBatches;
+    }
+    size_t storedTxsSize()
+    {
+        Guard l(x_storedTxs);
+        size_t txsSize = 0;
+        for (auto const& batch : m_storedBatches)
+        {
+            txsSize += batch.size();
+        }
+        return txsSize;
+    }
+
+private:
+    size_t m_failedTimes;
+    size_t m_calledTimes = 0;
+    std::vector<HashList> m_storedBatches;
+    Mutex x_storedTxs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(txsPreCommitterTest, TestPromptFixture)
+
+struct PreCommitterFaker
+{
+    PreCommitterFaker(size_t _failedTimes, size_t _batchSize, uint64_t _intervalMs)
+    {
+        cryptoSuite = createCryptoSuite();
+        faker = createTxPoolFaker(cryptoSuite);
+        ledger = std::make_shared<FakeStoreLedger>(faker->blockFactory(), _failedTimes);
+        auto config = std::make_shared<TxPoolConfig>(
+            nullptr, nullptr, faker->blockFactory(), ledger, nullptr);
+        preCommitter = std::make_shared<TxsPreCommitter>(config, _batchSize, _intervalMs);
+        preCommitter->start();
+    }
+    ~PreCommitterFaker()
+    {
+        preCommitter->stop();
+        faker->txpool()->stop();
+    }
+
+    HashList append(size_t _txsSize)
+    {
+        HashList txsHash;
+        auto blockLimit = faker->ledger()->blockNumber() + 10;
+        for (size_t i = 0; i < _txsSize; i++)
+        {
+            auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + (nonce++), blockLimit);
+            preCommitter->append(tx);
+            txsHash.emplace_back(tx->hash());
+        }
+        return txsHash;
+    }
+
+    CryptoSuite::Ptr cryptoSuite;
+    TxPoolFixture::Ptr faker;
+    FakeStoreLedger::Ptr ledger;
+    TxsPreCommitter::Ptr preCommitter;
+    size_t nonce = 0;
+};
+
+BOOST_AUTO_TEST_CASE(testBatchBySize)
+{
+    // the interval never elapses during the test
+    PreCommitterFaker preCommitterFaker(0, 5, 100000);
+    auto ledger = preCommitterFaker.ledger;
+    auto txsHash = preCommitterFaker.append(10);
+    BOOST_CHECK(waitUntil([&]() { return ledger->storedTxsSize() == txsHash.size(); }));
+    // the txs are stored in the appended order, and every batch is full
+    HashList storedTxs;
+    for (auto const& batch : ledger->storedBatches())
+    {
+        BOOST_CHECK_EQUAL(batch.size(), 5);
+        storedTxs.insert(storedTxs.end(), batch.begin(), batch.end());
+    }
+    BOOST_CHECK(storedTxs == txsHash);
+}
+
+BOOST_AUTO_TEST_CASE(testBatchByInterval)
+{
+    PreCommitterFaker preCommitterFaker(0, 100, 50);
+    auto ledger = preCommitterFaker.ledger;
+    auto txsHash = preCommitterFaker.append(3);
+    // the batch is stored once the interval elapsed, though not full
+    BOOST_CHECK(waitUntil([&]() { return ledger->storedTxsSize() == txsHash.size(); }));
+    auto batches = ledger->storedBatches();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_CHECK(batches[0] == txsHash);
+}
+
+BOOST_AUTO_TEST_CASE(testRetryFailedBatch)
+{
+    // the first two stores fail
+    PreCommitterFaker preCommitterFaker(2, 2, 100000);
+    auto ledger = preCommitterFaker.ledger;
+    auto txsHash = preCommitterFaker.append(2);
+    // retried with backoff by the worker
+    BOOST_CHECK(waitUntil([&]() { return ledger->storedTxsSize() == txsHash.size(); }));
+    BOOST_CHECK_EQUAL(ledger->calledTimes(), 3);
+    auto batches = ledger->storedBatches();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_CHECK(batches[0] == txsHash);
+}
+
+BOOST_AUTO_TEST_CASE(testFlushAtStop)
+{
+    // neither the batch size nor the interval reached before stop
+    PreCommitterFaker preCommitterFaker(0, 100, 100000);
+    auto ledger = preCommitterFaker.ledger;
+    auto txsHash = preCommitterFaker.append(3);
+    BOOST_CHECK_EQUAL(ledger->storedTxsSize(), 0);
+    auto startT = utcTime();
+    preCommitterFaker.preCommitter->stop();
+    // the worker waiting for the interval is woken up
+    BOOST_CHECK(utcTime() - startT < 10000);
+    auto batches = ledger->storedBatches();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_CHECK(batches[0] == txsHash);
+}
+
+BOOST_AUTO_TEST_CASE(testRetryFailedBatchAtStop)
+{
+    // the batch flushed at stop fails, and is retried before stopped
+    PreCommitterFaker preCommitterFaker(1, 100, 100000);
+    auto ledger = preCommitterFaker.ledger;
+    auto txsHash = preCommitterFaker.append(3);
+    preCommitterFaker.preCommitter->stop();
+    BOOST_CHECK_EQUAL(ledger->calledTimes(), 2);
+    auto batches = ledger->storedBatches();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_CHECK(batches[0] == txsHash);
+
+    // the batch failed twice at stop is dropped, never retried after stopped
+    PreCommitterFaker droppedFaker(2, 100, 100000);
+    droppedFaker.append(3);
+    droppedFaker.preCommitter->stop();
+    BOOST_CHECK_EQUAL(droppedFaker.ledger->calledTimes(), 2);
+    BOOST_CHECK_EQUAL(droppedFaker.ledger->storedTxsSize(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,194 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the TxsSenderLanes
+ * @file TxsSenderLanesTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-29
+ */
+#include "bcos-txpool/txpool/storage/TxsSenderLanes.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(txsSenderLanesTest, TestPromptFixture)
+
+Transaction::Ptr fakeLaneTx(CryptoSuite::Ptr _cryptoSuite, KeyPairInterface::Ptr _sender,
+    int64_t _importTime, u256 const& _nonce)
+{
+    std::string inputStr = "testTransaction";
+    auto tx = fakeTransaction(_cryptoSuite, _sender, bytes(20, 1),
+        bytes(inputStr.begin(), inputStr.end()), _nonce, 100, "chainId", "groupId");
+    tx->setImportTime(_importTime);
+    return tx;
+}
+
+// insert _txsSize txs for every sender, the txs of a sender are imported in ascending order
+std::vector<Transactions> fakeLanesTxs(CryptoSuite::Ptr _cryptoSuite,
+    TxsSenderLanes::Ptr _lanes, std::vector<size_t> const& _txsSizes)
+{
+    std::vector<Transactions> sendersTxs;
+    auto nonce = utcTime();
+    for (auto txsSize : _txsSizes)
+    {
+        auto sender = _cryptoSuite->signatureImpl()->generateKeyPair();
+        Transactions txs;
+        for (size_t i = 0; i < txsSize; i++)
+        {
+            txs.emplace_back(fakeLaneTx(_cryptoSuite, sender, i, nonce++));
+            _lanes->insert(txs.back());
+        }
+        sendersTxs.emplace_back(std::move(txs));
+    }
+    return sendersTxs;
+}
+
+std::map<std::string, size_t> countSenderTxs(ConstTransactions const& _txs)
+{
+    std::map<std::string, size_t> senderTxsSize;
+    for (auto const& tx : _txs)
+    {
+        senderTxsSize[std::string(tx->sender())]++;
+    }
+    return senderTxsSize;
+}
+
+auto const c_fetchAll = [](Transaction::ConstPtr const&) { return true; };
+
+BOOST_AUTO_TEST_CASE(testRoundRobin)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto lanes = std::make_shared<TxsSenderLanes>();
+    auto sendersTxs = fakeLanesTxs(cryptoSuite, lanes, {3, 3, 3, 3});
+
+    // every round takes one tx from every sender, the txs of a sender are fetched in order
+    auto txs = lanes->fetch(12, 0, c_fetchAll);
+    BOOST_REQUIRE_EQUAL(txs.size(), 12);
+    std::map<std::string, size_t> fetchedSize;
+    for (size_t round = 0; round < 3; round++)
+    {
+        std::set<std::string> senders;
+        for (size_t i = round * 4; i < (round + 1) * 4; i++)
+        {
+            auto sender = std::string(txs[i]->sender());
+            senders.insert(sender);
+            BOOST_CHECK_EQUAL(txs[i]->importTime(), (int64_t)fetchedSize[sender]++);
+        }
+        BOOST_CHECK_EQUAL(senders.size(), 4);
+    }
+    // every fetch resumes from the lane after the last visited lane
+    std::set<std::string> senders;
+    for (size_t i = 0; i < 4; i++)
+    {
+        auto fetchedTxs = lanes->fetch(1, 0, c_fetchAll);
+        BOOST_REQUIRE_EQUAL(fetchedTxs.size(), 1);
+        BOOST_CHECK_EQUAL(fetchedTxs[0]->importTime(), 0);
+        senders.insert(std::string(fetchedTxs[0]->sender()));
+    }
+    BOOST_CHECK_EQUAL(senders.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(testSenderLimit)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto lanes = std::make_shared<TxsSenderLanes>();
+    fakeLanesTxs(cryptoSuite, lanes, {5, 1, 3, 2});
+
+    auto txs = lanes->fetch(100, 2, c_fetchAll);
+    BOOST_CHECK_EQUAL(txs.size(), 7);
+    auto senderTxsSize = countSenderTxs(txs);
+    BOOST_CHECK_EQUAL(senderTxsSize.size(), 4);
+    for (auto const& it : senderTxsSize)
+    {
+        BOOST_CHECK(it.second <= 2);
+    }
+    // no limit
+    BOOST_CHECK_EQUAL(lanes->fetch(100, 0, c_fetchAll).size(), 11);
+    BOOST_CHECK(lanes->fetch(0, 0, c_fetchAll).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testImportTimeTiebreak)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto lanes = std::make_shared<TxsSenderLanes>();
+    auto sender = cryptoSuite->signatureImpl()->generateKeyPair();
+    auto nonce = utcTime();
+    // the txs imported at the same time are all kept and ordered by hash
+    Transactions txs;
+    for (size_t i = 0; i < 5; i++)
+    {
+        txs.emplace_back(fakeLaneTx(cryptoSuite, sender, 1, nonce + i));
+        lanes->insert(txs.back());
+    }
+    auto olderTx = fakeLaneTx(cryptoSuite, sender, 0, nonce + 5);
+    lanes->insert(olderTx);
+    // the same tx is inserted only once
+    lanes->insert(txs[0]);
+
+    auto fetchedTxs = lanes->fetch(100, 0, c_fetchAll);
+    BOOST_REQUIRE_EQUAL(fetchedTxs.size(), txs.size() + 1);
+    BOOST_CHECK(fetchedTxs[0] == olderTx);
+    std::sort(txs.begin(), txs.end(),
+        [](Transaction::Ptr const& _first, Transaction::Ptr const& _second) {
+            return _first->hash() < _second->hash();
+        });
+    for (size_t i = 0; i < txs.size(); i++)
+    {
+        BOOST_CHECK(fetchedTxs[i + 1] == txs[i]);
+    }
+    // the erased tx is located by the same order
+    lanes->erase(txs[2]);
+    BOOST_CHECK_EQUAL(lanes->fetch(100, 0, c_fetchAll).size(), txs.size());
+}
+
+BOOST_AUTO_TEST_CASE(testFloodingSender)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto lanes = std::make_shared<TxsSenderLanes>();
+    auto sendersTxs = fakeLanesTxs(cryptoSuite, lanes, {100, 2, 2, 2});
+    auto floodingSender = std::string(sendersTxs[0][0]->sender());
+
+    // the flooding sender takes no more than its turn
+    auto txs = lanes->fetch(8, 0, c_fetchAll);
+    BOOST_CHECK_EQUAL(txs.size(), 8);
+    auto senderTxsSize = countSenderTxs(txs);
+    BOOST_CHECK_EQUAL(senderTxsSize.size(), 4);
+    for (auto const& it : senderTxsSize)
+    {
+        BOOST_CHECK_EQUAL(it.second, 2);
+    }
+    // the flooding sender takes the rest once the light senders exhausted
+    txs = lanes->fetch(20, 0, c_fetchAll);
+    BOOST_CHECK_EQUAL(txs.size(), 20);
+    BOOST_CHECK_EQUAL(countSenderTxs(txs)[floodingSender], 14);
+    // the filtered txs are skipped without consuming the turn of the sender
+    txs = lanes->fetch(100, 0, [&floodingSender](Transaction::ConstPtr const& _tx) {
+        return std::string(_tx->sender()) != floodingSender;
+    });
+    BOOST_CHECK_EQUAL(txs.size(), 6);
+    BOOST_CHECK_EQUAL(countSenderTxs(txs).count(floodingSender), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
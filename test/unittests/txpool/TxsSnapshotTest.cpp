@@ -0,0 +1,185 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the TxsSnapshot
+ * @file TxsSnapshotTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-29
+ */
+#include "bcos-txpool/txpool/storage/TxsSnapshot.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(txsSnapshotTest, TestPromptFixture)
+
+std::string snapshotPath(std::string const& _name)
+{
+    return "./" + _name + "_" + std::to_string(utcTime()) + ".snapshot";
+}
+
+TxsSnapshot::Ptr createTxsSnapshot(std::string const& _path)
+{
+    return std::make_shared<TxsSnapshot>(
+        _path, 60000, []() { return std::make_shared<ConstTransactions>(); });
+}
+
+bytes readSnapshot(std::string const& _path)
+{
+    std::ifstream in(_path, std::ios::binary);
+    return bytes(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeSnapshot(std::string const& _path, bytes const& _data)
+{
+    std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+    out.write((char const*)_data.data(), _data.size());
+}
+
+// store the txs into the snapshot file
+Transactions storeTxs(CryptoSuite::Ptr _cryptoSuite, TxPoolFixture::Ptr _faker,
+    TxsSnapshot::Ptr _snapshot, size_t _txsSize)
+{
+    auto blockLimit = _faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    ConstTransactions snapshotTxs;
+    for (size_t i = 0; i < _txsSize; i++)
+    {
+        txs.emplace_back(fakeTx(_cryptoSuite, _faker, utcTime() + 1000 + i, blockLimit));
+        snapshotTxs.emplace_back(txs.back());
+    }
+    BOOST_CHECK(_snapshot->store(snapshotTxs));
+    return txs;
+}
+
+// the loaded txs should be the prefix of the stored txs
+void checkLoadedTxs(TxPoolFixture::Ptr _faker, Transactions const& _txs,
+    std::shared_ptr<std::vector<bytesPointer>> _encodedTxs, size_t _expectedSize)
+{
+    BOOST_REQUIRE_EQUAL(_encodedTxs->size(), _expectedSize);
+    auto txFactory = _faker->txpool()->txpoolConfig()->txFactory();
+    for (size_t i = 0; i < _encodedTxs->size(); i++)
+    {
+        auto tx = txFactory->createTransaction(ref(*((*_encodedTxs)[i])), false);
+        BOOST_CHECK(tx->hash() == _txs[i]->hash());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testStoreAndLoad)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto path = snapshotPath("testStoreAndLoad");
+    auto snapshot = createTxsSnapshot(path);
+    BOOST_CHECK(snapshot->load()->empty());
+
+    auto txs = storeTxs(cryptoSuite, faker, snapshot, 10);
+    checkLoadedTxs(faker, txs, snapshot->load(), txs.size());
+    // the latest snapshot replaces the last one
+    txs = storeTxs(cryptoSuite, faker, snapshot, 5);
+    checkLoadedTxs(faker, txs, snapshot->load(), txs.size());
+    // the empty snapshot
+    txs = storeTxs(cryptoSuite, faker, snapshot, 0);
+    BOOST_CHECK(snapshot->load()->empty());
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testLoadCorruptedSnapshot)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto path = snapshotPath("testLoadCorruptedSnapshot");
+    auto snapshot = createTxsSnapshot(path);
+    auto txs = storeTxs(cryptoSuite, faker, snapshot, 10);
+    auto data = readSnapshot(path);
+
+    // the txs before the truncated one are loaded
+    writeSnapshot(path, bytes(data.begin(), data.end() - 1));
+    checkLoadedTxs(faker, txs, snapshot->load(), txs.size() - 1);
+    // the header only
+    size_t headerSize = 16;
+    writeSnapshot(path, bytes(data.begin(), data.begin() + headerSize));
+    BOOST_CHECK(snapshot->load()->empty());
+    // the truncated header
+    writeSnapshot(path, bytes(data.begin(), data.begin() + headerSize - 1));
+    BOOST_CHECK(snapshot->load()->empty());
+
+    // the txs after the corrupted length are dropped
+    auto corruptedData = data;
+    auto offset = headerSize;
+    for (size_t i = 0; i < 3; i++)
+    {
+        offset += 4 + txs[i]->encode(false).size();
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        corruptedData[offset + i] = 0xff;
+    }
+    writeSnapshot(path, corruptedData);
+    checkLoadedTxs(faker, txs, snapshot->load(), 3);
+
+    // the corrupted magic
+    corruptedData = data;
+    corruptedData[0] ^= 0xff;
+    writeSnapshot(path, corruptedData);
+    BOOST_CHECK(snapshot->load()->empty());
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testReloadTxs)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), cryptoSuite, "test-group", "test-chain", 15, fakeGateWay);
+    auto path = snapshotPath("testReloadTxs");
+    auto txs = storeTxs(cryptoSuite, faker, createTxsSnapshot(path), 10);
+
+    // the txs are reloaded when the txpool initialized
+    faker->txpool()->txpoolConfig()->setSnapshotPath(path);
+    faker->init();
+    auto storage = faker->txpool()->txpoolStorage();
+    BOOST_CHECK_EQUAL(storage->size(), txs.size());
+    for (auto const& tx : txs)
+    {
+        BOOST_CHECK(storage->exist(tx->hash()));
+    }
+    // the reloaded txs are not broadcast again
+    BOOST_CHECK(storage->fetchNewTxs(100)->empty());
+    // the reloaded txs are pre-committed again, since their batch may not be flushed before the
+    // restart
+    auto const& txsHash2Data = faker->ledger()->txsHashToData();
+    for (auto const& tx : txs)
+    {
+        BOOST_CHECK(waitUntil([&]() { return txsHash2Data.count(tx->hash()) > 0; }));
+    }
+    faker->txpool()->stop();
+    std::remove(path.c_str());
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the TxsSubmitPipeline
+ * @file TxsSubmitPipelineTest.cpp
+ * @author: yujiechen
+ * @date 2021-10-27
+ */
+#include "bcos-txpool/txpool/storage/TxsSubmitPipeline.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(txsSubmitPipelineTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testShedWhenStageFull)
+{
+    std::atomic<size_t> rejectedSize = {0};
+    std::atomic<size_t> failedSize = {0};
+    std::atomic<size_t> insertedSize = {0};
+    auto pipeline = std::make_shared<TxsSubmitPipeline>(
+        [&](TxSubmitTask const&, TransactionStatus _status) {
+            if (_status == TransactionStatus::TxPoolIsFull)
+            {
+                rejectedSize++;
+                return;
+            }
+            failedSize++;
+        });
+    std::promise<void> unblocked;
+    auto unblockedFuture = unblocked.get_future().share();
+    size_t capacity = 10;
+    // the first stage fails the odd txs, the second stage is blocked until all submitted
+    pipeline->appendStage("checker", 2, capacity, [](TxSubmitTask& _task) {
+        return (_task.txData->size() % 2) ? TransactionStatus::Malform : TransactionStatus::None;
+    });
+    pipeline->appendStage("inserter", 1, capacity, [&](TxSubmitTask&) {
+        unblockedFuture.wait();
+        insertedSize++;
+        return TransactionStatus::None;
+    });
+    size_t submittedSize = 1000;
+    size_t acceptedSize = 0;
+    for (size_t i = 0; i < submittedSize; i++)
+    {
+        auto task = std::make_shared<TxSubmitTask>();
+        task->txData = std::make_shared<bytes>(i % 2, 0);
+        if (pipeline->submit(task) == TransactionStatus::None)
+        {
+            acceptedSize++;
+        }
+    }
+    unblocked.set_value();
+    BOOST_CHECK(waitUntil(
+        [&]() { return insertedSize + failedSize + rejectedSize >= submittedSize; }));
+    pipeline->stop();
+    // the queues are bounded, the blocked stage sheds the txs instead of queuing all of them
+    // Note: the txs queued by the checker are forwarded after the inserter unblocked
+    BOOST_CHECK(insertedSize > 0);
+    BOOST_CHECK(insertedSize <= 2 * capacity);
+    BOOST_CHECK(failedSize > 0);
+    BOOST_CHECK(rejectedSize > 0);
+    BOOST_CHECK_EQUAL(submittedSize - acceptedSize, pipeline->metrics()[0].rejectedCount);
+    for (auto const& stageMetrics : pipeline->metrics())
+    {
+        BOOST_CHECK_EQUAL(stageMetrics.depth, 0);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
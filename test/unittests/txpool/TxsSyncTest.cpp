@@ -18,6 +18,8 @@
  * @author: yujiechen
  * @date 2021-05-26
  */
+#include "bcos-txpool/txpool/storage/MissedTxsTracker.h"
+#include "bcos-txpool/txpool/storage/UnsealedTxsNotifier.h"
 #include "test/unittests/txpool/TxPoolFixture.h"
 #include <bcos-framework/interfaces/crypto/CryptoSuite.h>
 #include <bcos-framework/testutils/TestPromptFixture.h>
@@ -224,6 +226,142 @@ BOOST_AUTO_TEST_CASE(testOnPeerTxsStatus)
 {
     testTransactionSync(true);
 }
+BOOST_AUTO_TEST_CASE(testFetchNewTxs)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto faker = createTxPoolFaker(cryptoSuite);
+    auto storage = std::make_shared<MemoryStorage>(faker->txpool()->txpoolConfig());
+    auto blockLimit = faker->ledger()->blockNumber() + 10;
+    Transactions txs;
+    for (size_t i = 0; i < 10; i++)
+    {
+        auto tx = fakeTx(cryptoSuite, faker, utcTime() + 1000 + i, blockLimit);
+        storage->insert(tx);
+        txs.emplace_back(tx);
+    }
+    // the new txs are drained in the order of the import, up to the limit
+    auto newTxs = storage->fetchNewTxs(4);
+    BOOST_REQUIRE_EQUAL(newTxs->size(), 4);
+    for (size_t i = 0; i < newTxs->size(); i++)
+    {
+        BOOST_CHECK((*newTxs)[i] == txs[i]);
+        BOOST_CHECK(txs[i]->synced());
+    }
+    // the removed tx is skipped
+    storage->remove(txs[5]->hash());
+    newTxs = storage->fetchNewTxs(100);
+    BOOST_REQUIRE_EQUAL(newTxs->size(), 5);
+    size_t index = 0;
+    for (auto i : {4, 6, 7, 8, 9})
+    {
+        BOOST_CHECK((*newTxs)[index++] == txs[i]);
+    }
+    // the drained txs are never fetched again
+    BOOST_CHECK(storage->fetchNewTxs(100)->empty());
+
+    // only the txs not synced yet are new
+    auto syncedTx = fakeTx(cryptoSuite, faker, utcTime() + 1010, blockLimit);
+    syncedTx->setSynced(true);
+    storage->insert(syncedTx);
+    auto newTx = fakeTx(cryptoSuite, faker, utcTime() + 1011, blockLimit);
+    storage->insert(newTx);
+    newTxs = storage->fetchNewTxs(100);
+    BOOST_REQUIRE_EQUAL(newTxs->size(), 1);
+    BOOST_CHECK((*newTxs)[0] == newTx);
+    storage->stop();
+}
+BOOST_AUTO_TEST_CASE(testMissedTxsTracker)
+{
+    auto cryptoSuite = createCryptoSuite();
+    auto hashImpl = cryptoSuite->hashImpl();
+    auto peerA = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    auto peerB = cryptoSuite->signatureImpl()->generateKeyPair()->publicKey();
+    HashList txsHash;
+    for (size_t i = 0; i < 3; i++)
+    {
+        txsHash.emplace_back(hashImpl->hash(std::to_string(i)));
+    }
+    // every generation covers 100ms
+    uint64_t expiration = 400;
+    auto tracker = std::make_shared<MissedTxsTracker>(expiration, 10000);
+    BOOST_CHECK_EQUAL(tracker->request(HashList{txsHash[0], txsHash[1]}, peerA)->size(), 2);
+    // only the txs not requested recently are requested
+    auto requestTxs = tracker->request(txsHash, peerA);
+    BOOST_REQUIRE_EQUAL(requestTxs->size(), 1);
+    BOOST_CHECK((*requestTxs)[0] == txsHash[2]);
+    // the tx requested from another peer just now is not requested again
+    BOOST_CHECK(tracker->request(HashList{txsHash[0]}, peerB)->empty());
+
+    // retry with another peer once the requested peer has not responded for a generation
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    requestTxs = tracker->request(HashList{txsHash[0]}, peerB);
+    BOOST_REQUIRE_EQUAL(requestTxs->size(), 1);
+    BOOST_CHECK((*requestTxs)[0] == txsHash[0]);
+    BOOST_CHECK(tracker->request(HashList{txsHash[0]}, peerA)->empty());
+    // the same peer is not retried before the record expires
+    BOOST_CHECK(tracker->request(HashList{txsHash[1]}, peerA)->empty());
+    // the received tx can be requested again
+    tracker->remove(txsHash[1]);
+    BOOST_CHECK_EQUAL(tracker->request(HashList{txsHash[1]}, peerA)->size(), 1);
+
+    // all the records expire
+    std::this_thread::sleep_for(std::chrono::milliseconds(expiration + 100));
+    BOOST_CHECK_EQUAL(tracker->request(txsHash, peerA)->size(), txsHash.size());
+    tracker->clear();
+    BOOST_CHECK_EQUAL(tracker->request(txsHash, peerB)->size(), txsHash.size());
+}
+BOOST_AUTO_TEST_CASE(testUnsealedTxsNotifier)
+{
+    uint64_t interval = 1000;
+    auto notifier = std::make_shared<UnsealedTxsNotifier>(interval, 100);
+    Mutex x_notifiedSizes;
+    std::vector<size_t> notifiedSizes;
+    notifier->setNotifier([&](size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecv) {
+        {
+            Guard l(x_notifiedSizes);
+            notifiedSizes.emplace_back(_unsealedTxsSize);
+        }
+        _onRecv(nullptr);
+    });
+    auto notified = [&](std::vector<size_t> const& _expectedSizes) {
+        Guard l(x_notifiedSizes);
+        return notifiedSizes == _expectedSizes;
+    };
+    // the significant change is notified without waiting for the interval
+    auto checkNotifiedPromptly = [&](std::vector<size_t> const& _expectedSizes) {
+        BOOST_CHECK(waitUntil([&]() { return notified(_expectedSizes); }, interval / 2));
+        // wait for the worker to sleep again
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    };
+    notifier->start();
+    checkNotifiedPromptly({0});
+
+    // becomes non-empty
+    notifier->update(10);
+    checkNotifiedPromptly({0, 10});
+    // the small changes are coalesced
+    notifier->update(20);
+    notifier->update(30);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    BOOST_CHECK(notified({0, 10}));
+    // changes by the threshold
+    notifier->update(150);
+    checkNotifiedPromptly({0, 10, 150});
+    // becomes empty and non-empty again
+    notifier->update(0);
+    checkNotifiedPromptly({0, 10, 150, 0});
+    notifier->update(5);
+    checkNotifiedPromptly({0, 10, 150, 0, 5});
+
+    // the small changes are notified once with the latest size after the interval
+    for (size_t unsealedTxsSize = 6; unsealedTxsSize <= 20; unsealedTxsSize++)
+    {
+        notifier->update(unsealedTxsSize);
+    }
+    BOOST_CHECK(notified({0, 10, 150, 0, 5}));
+    BOOST_CHECK(waitUntil([&]() { return notified({0, 10, 150, 0, 5, 20}); }, 3 * interval));
+    notifier->stop();
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos